@@ -0,0 +1,591 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ustream/islot.hpp"
+#include "ustream/signal.hpp"
+#include "ustream/flat_signal.hpp"
+#include "ustream/broadcast.hpp"
+#include "ustream/global_broadcast.hpp"
+#include "ustream/mailbox_slot.hpp"
+#include "ustream/thread_pool.hpp"
+#include "ustream/fan_out.hpp"
+#include "ustream/queued_slot.hpp"
+#include "ustream/multicast_ring.hpp"
+
+namespace {
+
+    using bench_clock_t = std::chrono::steady_clock;
+
+    // results
+
+    struct Result {
+        std::string mSuite;
+        std::string mVariant;
+        std::vector<std::pair<std::string, long>> mParams;
+        std::string mMetric;
+        double mValue;
+    };
+
+    std::vector<Result> sResults;
+
+    void record(
+        std::string inSuite,
+        std::string inVariant,
+        std::vector<std::pair<std::string, long>> inParams,
+        std::string inMetric,
+        double inValue
+    ) {
+        sResults.push_back({ std::move(inSuite), std::move(inVariant), std::move(inParams), std::move(inMetric), inValue });
+    }
+
+    void printJson() {
+        std::printf("{\n  \"benchmarks\": [\n");
+        for (std::size_t i = 0; i < sResults.size(); i++) {
+            const auto& r = sResults[i];
+            std::printf("    { \"suite\": \"%s\", \"variant\": \"%s\"", r.mSuite.c_str(), r.mVariant.c_str());
+            for (const auto& [name, value] : r.mParams) {
+                std::printf(", \"%s\": %ld", name.c_str(), value);
+            }
+            std::printf(", \"%s\": %.3f }%s\n", r.mMetric.c_str(), r.mValue, i + 1 == sResults.size() ? "" : ",");
+        }
+        std::printf("  ]\n}\n");
+    }
+
+    template<typename func_t>
+    double nsPerCall(std::size_t iterations, func_t&& f) {
+        const auto start = bench_clock_t::now();
+        for (std::size_t i = 0; i < iterations; i++) {
+            f(i);
+        }
+        const auto stop = bench_clock_t::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+    }
+
+    template<typename func_t>
+    double nsOnce(func_t&& f) {
+        const auto start = bench_clock_t::now();
+        f();
+        const auto stop = bench_clock_t::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+
+    // emit latency vs slot count
+
+    template<typename slot_base_t>
+    struct CountingSlot : slot_base_t {
+        void processSignal(int i) override {
+            mSum += i;
+        }
+        long mSum = 0;
+        // spreads the slots over distinct cache lines
+        char mPadding[192];
+    };
+
+    using Slot = CountingSlot<ustream::ISlot<int>>;
+    using FlatSlot = CountingSlot<ustream::IFlatSlot<int>>;
+
+    // slots scattered in memory and connected in a random order
+    template<typename slot_t>
+    struct SlotPool {
+
+        explicit SlotPool(std::size_t inCount) {
+            for (std::size_t i = 0; i < inCount; i++) {
+                mSlots.emplace_back(new slot_t);
+            }
+            std::shuffle(mSlots.begin(), mSlots.end(), std::mt19937(42));
+        }
+
+        long sum() const {
+            long s = 0;
+            for (const auto& slot : mSlots) {
+                s += slot->mSum;
+            }
+            return s;
+        }
+
+        std::vector<std::unique_ptr<slot_t>> mSlots;
+    };
+
+    constexpr std::size_t kMaxSlots = 512;
+
+    void benchEmit() {
+
+        for (std::size_t count : { 1, 4, 16, 64, 256, 512 }) {
+
+            const std::size_t iterations = 2000000 / count;
+
+            SlotPool<Slot> listPool(count);
+            ustream::Signal<int> listSignal;
+            for (auto& s : listPool.mSlots) {
+                listSignal.connect(*s);
+            }
+
+            SlotPool<FlatSlot> flatPool(count);
+            ustream::FlatSignal<kMaxSlots, int> flatSignal;
+            for (auto& s : flatPool.mSlots) {
+                flatSignal.connect(*s);
+            }
+
+            const double listNs = nsPerCall(iterations, [&](std::size_t i) { listSignal.emit(static_cast<int>(i)); });
+            const double flatNs = nsPerCall(iterations, [&](std::size_t i) { flatSignal.emit(static_cast<int>(i)); });
+
+            if (listPool.sum() != flatPool.sum()) {
+                std::fprintf(stderr, "emit : result mismatch\n");
+            }
+
+            const long slots = static_cast<long>(count);
+            record("emit", "Signal", { { "slots", slots } }, "ns_per_emit", listNs);
+            record("emit", "FlatSignal", { { "slots", slots } }, "ns_per_emit", flatNs);
+
+            if (count == 1) {
+                // baseline : virtual call through a pointer the compiler can't follow
+                Slot direct;
+                ustream::ISlot<int>* volatile target = &direct;
+                record("emit", "virtual call", { { "slots", slots } }, "ns_per_emit",
+                    nsPerCall(iterations, [&](std::size_t i) { target->processSignal(static_cast<int>(i)); }));
+            }
+        }
+    }
+
+    // broadcast vs direct signal
+
+    struct SharedCounter : ustream::ISharedSlot<int> {
+        ~SharedCounter() {
+            disconnect();
+        }
+        void processSignal(int i) override {
+            mSum += i;
+        }
+        long mSum = 0;
+    };
+
+    void benchBroadcast() {
+
+        constexpr std::size_t kIterations = 2000000;
+
+        for (long count : { 1, 4, 16 }) {
+
+            std::vector<Slot> directSlots(static_cast<std::size_t>(count));
+            std::vector<Slot> portSlots(static_cast<std::size_t>(count));
+            std::vector<SharedCounter> sharedSlots(static_cast<std::size_t>(count));
+
+            ustream::Signal<int> signal;
+
+            for (long i = 0; i < count; i++) {
+                signal.connect(directSlots[i]);
+                ustream::open<100>(portSlots[i]);
+                ustream::global::open<100>(sharedSlots[i]);
+            }
+
+            record("broadcast", "Signal::emit", { { "slots", count } }, "ns_per_emit",
+                nsPerCall(kIterations, [&](std::size_t i) { signal.emit(static_cast<int>(i)); }));
+
+            record("broadcast", "broadcast", { { "slots", count } }, "ns_per_emit",
+                nsPerCall(kIterations, [&](std::size_t i) { ustream::broadcast<100>(static_cast<int>(i)); }));
+
+            record("broadcast", "global::broadcast", { { "slots", count } }, "ns_per_emit",
+                nsPerCall(kIterations, [&](std::size_t i) { ustream::global::broadcast<100>(static_cast<int>(i)); }));
+
+            for (auto& s : portSlots) {
+                ustream::close(s);
+            }
+        }
+    }
+
+    // first call cost of the thread local broadcast ports
+
+    template<std::size_t ... addresses>
+    void firstCalls(std::index_sequence<addresses...>, double& outFirst, double& outNext) {
+        outFirst = 0;
+        outNext = 0;
+        ((outFirst += nsOnce([] { ustream::broadcast<1000 + addresses>(1); })), ...);
+        ((outNext += nsOnce([] { ustream::broadcast<1000 + addresses>(1); })), ...);
+        outFirst /= sizeof...(addresses);
+        outNext /= sizeof...(addresses);
+    }
+
+    void benchFirstCall() {
+
+        constexpr int kThreads = 16;
+
+        double first = 0;
+        double next = 0;
+
+        for (int t = 0; t < kThreads; t++) {
+            std::thread([&] {
+                double f;
+                double n;
+                firstCalls(std::make_index_sequence<32>(), f, n);
+                first += f;
+                next += n;
+            }).join();
+        }
+
+        record("first_call", "broadcast", {}, "ns_first_call", first / kThreads);
+        record("first_call", "broadcast", {}, "ns_next_call", next / kThreads);
+    }
+
+    // connection churn
+
+    void benchChurn() {
+
+        constexpr std::size_t kIterations = 1000000;
+
+        {
+            ustream::Signal<int> signal;
+            Slot others[8];
+            for (auto& s : others) {
+                signal.connect(s);
+            }
+            Slot s;
+            record("churn", "Signal", { { "slots", 8 } }, "ns_per_connect_disconnect",
+                nsPerCall(kIterations, [&](std::size_t) {
+                    signal.connect(s);
+                    s.disconnect();
+                }));
+        }
+
+        {
+            ustream::FlatSignal<16, int> signal;
+            FlatSlot others[8];
+            for (auto& s : others) {
+                signal.connect(s);
+            }
+            FlatSlot s;
+            record("churn", "FlatSignal", { { "slots", 8 } }, "ns_per_connect_disconnect",
+                nsPerCall(kIterations, [&](std::size_t) {
+                    signal.connect(s);
+                    s.disconnect();
+                }));
+        }
+
+        {
+            ustream::SharedSignal<int> signal;
+            SharedCounter others[8];
+            for (auto& s : others) {
+                signal.connect(s);
+            }
+            SharedCounter s;
+            record("churn", "SharedSignal", { { "slots", 8 } }, "ns_per_connect_disconnect",
+                nsPerCall(kIterations / 10, [&](std::size_t) {
+                    signal.connect(s);
+                    s.disconnect();
+                }));
+        }
+    }
+
+    // payload size sensitivity
+
+    template<std::size_t size>
+    struct Payload {
+        Payload() = default;
+        Payload(const Payload& other) : mSequence(other.mSequence) {
+            std::copy(std::begin(other.mData), std::end(other.mData), std::begin(mData));
+            sCopies++;
+        }
+        long mSequence = 0;
+        char mData[size] = {};
+        static inline long sCopies = 0;
+    };
+
+    template<typename arg_t>
+    struct PayloadSlot : ustream::ISlot<arg_t> {
+        void processSignal(arg_t p) override {
+            mSum += p.mSequence + p.mData[static_cast<std::size_t>(p.mSequence) % sizeof(p.mData)];
+        }
+        long mSum = 0;
+    };
+
+    template<std::size_t size, typename arg_t, auto address>
+    void benchPayloadPath(const char* inVariant) {
+
+        using payload_t = Payload<size>;
+
+        constexpr std::size_t kSlots = 4;
+        constexpr std::size_t kIterations = 500000;
+
+        PayloadSlot<arg_t> slots[kSlots];
+        for (auto& s : slots) {
+            ustream::open<address>(s);
+        }
+
+        payload_t p;
+        payload_t::sCopies = 0;
+
+        const double ns = nsPerCall(kIterations, [&](std::size_t i) {
+            p.mSequence = static_cast<long>(i);
+            ustream::broadcast<address>(p);
+        });
+
+        const long bytes = static_cast<long>(size);
+        record("payload", inVariant, { { "bytes", bytes }, { "slots", kSlots } }, "ns_per_broadcast", ns);
+        record("payload", inVariant, { { "bytes", bytes }, { "slots", kSlots } }, "copies_per_broadcast",
+            static_cast<double>(payload_t::sCopies) / kIterations);
+
+        for (auto& s : slots) {
+            ustream::close(s);
+        }
+    }
+
+    template<std::size_t size>
+    void benchPayloadSize() {
+        benchPayloadPath<size, Payload<size>, 200 + size>("by_value");
+        benchPayloadPath<size, const Payload<size>&, 200 + size>("by_const_ref");
+    }
+
+    void benchPayload() {
+        benchPayloadSize<8>();
+        benchPayloadSize<64>();
+        benchPayloadSize<256>();
+        benchPayloadSize<1024>();
+    }
+
+    // mailbox fan-in
+
+    struct Counter : ustream::ISlot<int> {
+        void processSignal(int i) override {
+            mSum += i;
+            mCount++;
+        }
+        long mSum = 0;
+        long mCount = 0;
+    };
+
+    void benchMailbox() {
+
+        constexpr long kMessages = 1 << 20;
+
+        for (long producers : { 1, 2, 4, 8 }) {
+
+            Counter counter;
+            ustream::MailboxSlot<4096, int> mailbox(counter);
+
+            const long perProducer = kMessages / producers;
+            std::atomic<long> running { producers };
+            std::atomic<long> retries { 0 };
+            const auto start = bench_clock_t::now();
+
+            std::vector<std::thread> threads;
+            for (long p = 0; p < producers; p++) {
+                threads.emplace_back([&] {
+                    long localRetries = 0;
+                    for (long i = 0; i < perProducer; i++) {
+                        while (!mailbox.push(1)) {
+                            // full : let the consumer run
+                            localRetries++;
+                            std::this_thread::yield();
+                        }
+                    }
+                    retries.fetch_add(localRetries);
+                    running.fetch_sub(1);
+                });
+            }
+
+            // drains until every producer is done and the mailbox is empty
+            while (true) {
+                // read before draining : the pushes of finished producers are visible
+                const bool done = running.load() == 0;
+                if (mailbox.drain() == 0) {
+                    if (done) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+
+            const auto stop = bench_clock_t::now();
+
+            for (auto& t : threads) {
+                t.join();
+            }
+
+            if (counter.mCount != perProducer * producers) {
+                std::fprintf(stderr, "mailbox : result mismatch\n");
+            }
+
+            const double seconds = std::chrono::duration<double>(stop - start).count();
+
+            record("mailbox", "MailboxSlot", { { "producers", producers } }, "mmsg_per_s", counter.mCount / seconds / 1e6);
+            record("mailbox", "MailboxSlot", { { "producers", producers } }, "retries", static_cast<double>(retries.load()));
+        }
+    }
+
+    // serial vs parallel emit of heavy slots
+
+    struct Extractor : ustream::ISlot<const std::vector<float>&> {
+        void processSignal(const std::vector<float>& inFrame) override {
+            float acc = 0;
+            for (int pass = 0; pass < 50; pass++) {
+                for (float v : inFrame) {
+                    acc += v * v;
+                }
+            }
+            mResult = acc;
+        }
+        float mResult = 0;
+    };
+
+    void benchFanOut() {
+
+        constexpr std::size_t kSlots = 8;
+        constexpr std::size_t kIterations = 100;
+
+        const std::vector<float> frame(4096, 0.5f);
+
+        Extractor extractors[kSlots];
+        ustream::Signal<const std::vector<float>&> signal;
+        for (auto& e : extractors) {
+            signal.connect(e);
+        }
+
+        ustream::ThreadPool<kSlots - 1> pool;
+        ustream::FanOut<kSlots, const std::vector<float>&> fanOut;
+
+        const long slots = static_cast<long>(kSlots);
+        const long threads = static_cast<long>(std::thread::hardware_concurrency());
+
+        record("fan_out", "Signal::emit", { { "slots", slots }, { "cores", threads } }, "us_per_emit",
+            nsPerCall(kIterations, [&](std::size_t) { signal.emit(frame); }) / 1000);
+
+        record("fan_out", "FanOut::emit", { { "slots", slots }, { "cores", threads } }, "us_per_emit",
+            nsPerCall(kIterations, [&](std::size_t) { fanOut.emit(pool, signal, frame); }) / 1000);
+    }
+
+
+    // one producer, several consumer threads : multicast ring vs one queue per consumer
+
+    struct Frame {
+        long mSequence = 0;
+        char mData[256] = {};
+    };
+
+    struct FrameSlot : ustream::ISlot<const Frame&> {
+        void processSignal(const Frame& f) override {
+            mSum += f.mSequence + f.mData[static_cast<std::size_t>(f.mSequence) % sizeof(f.mData)];
+            mCount++;
+        }
+        long mSum = 0;
+        std::atomic<long> mCount { 0 };
+    };
+
+    constexpr long kFrames = 1 << 18;
+    constexpr std::size_t kConsumers = 3;
+
+    template<typename wait_t>
+    void benchMulticastRing(const char* inVariant) {
+
+        using ring_t = ustream::MulticastRing<Frame, 1024, kConsumers, wait_t>;
+
+        ring_t ring;
+        FrameSlot slots[kConsumers];
+        std::unique_ptr<typename ring_t::Consumer> consumers[kConsumers];
+        std::thread threads[kConsumers];
+
+        for (std::size_t i = 0; i < kConsumers; i++) {
+            consumers[i].reset(new typename ring_t::Consumer(slots[i]));
+            ring.attach(*consumers[i]);
+        }
+
+        for (std::size_t i = 0; i < kConsumers; i++) {
+            threads[i] = std::thread([&, i] { while (consumers[i]->wait() != 0); });
+        }
+
+        ustream::Signal<const Frame&> signal;
+        signal.connect(ring);
+
+        Frame frame;
+        const auto start = bench_clock_t::now();
+
+        for (long i = 0; i < kFrames; i++) {
+            frame.mSequence = i;
+            signal.emit(frame);
+        }
+
+        ring.close();
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        const double seconds = std::chrono::duration<double>(bench_clock_t::now() - start).count();
+
+        record("multicast", inVariant, { { "consumers", static_cast<long>(kConsumers) } }, "mframes_per_s", kFrames / seconds / 1e6);
+    }
+
+    void benchQueuedConsumers() {
+
+        FrameSlot slots[kConsumers];
+        std::unique_ptr<ustream::QueuedSlot<1024, const Frame&>> queues[kConsumers];
+        std::thread threads[kConsumers];
+
+        // a queued slot per consumer : the frame is copied in each queue
+        for (std::size_t i = 0; i < kConsumers; i++) {
+            queues[i].reset(new ustream::QueuedSlot<1024, const Frame&>(slots[i]));
+        }
+
+        for (std::size_t i = 0; i < kConsumers; i++) {
+            threads[i] = std::thread(
+                [&, i] {
+                    while (slots[i].mCount != kFrames) {
+                        if (queues[i]->drain() == 0) {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+            );
+        }
+
+        Frame frame;
+        const auto start = bench_clock_t::now();
+
+        for (long i = 0; i < kFrames; i++) {
+            frame.mSequence = i;
+            for (auto& q : queues) {
+                // retries until the queue accepts the frame
+                auto dropped = q->dropped();
+                q->processSignal(frame);
+                while (q->dropped() != dropped) {
+                    dropped = q->dropped();
+                    std::this_thread::yield();
+                    q->processSignal(frame);
+                }
+            }
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        const double seconds = std::chrono::duration<double>(bench_clock_t::now() - start).count();
+
+        record("multicast", "QueuedSlot", { { "consumers", static_cast<long>(kConsumers) } }, "mframes_per_s", kFrames / seconds / 1e6);
+    }
+
+    void benchMulticast() {
+        benchQueuedConsumers();
+        benchMulticastRing<ustream::SpinWait>("MulticastRing<SpinWait>");
+        benchMulticastRing<ustream::YieldWait>("MulticastRing<YieldWait>");
+        benchMulticastRing<ustream::BlockWait>("MulticastRing<BlockWait>");
+    }
+}
+
+int main() {
+    benchEmit();
+    benchBroadcast();
+    benchFirstCall();
+    benchChurn();
+    benchPayload();
+    benchMailbox();
+    benchFanOut();
+    benchMulticast();
+    printJson();
+    return 0;
+}
@@ -0,0 +1,131 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "islot.hpp"
+
+namespace ustream {
+
+    namespace detail {
+
+        template<typename ... args_t>
+        struct AwaitResult {
+            using type = std::tuple<std::decay_t<args_t>...>;
+        };
+
+        template<typename arg_t>
+        struct AwaitResult<arg_t> {
+            using type = std::decay_t<arg_t>;
+        };
+
+        template<>
+        struct AwaitResult<> {
+            using type = void;
+        };
+
+    }
+
+    /**
+     * @brief Awaitable resuming a coroutine on the next emission of a source.
+     *
+     * The awaiter is the slot connected to the source while the coroutine
+     * is suspended, so it lives in the coroutine frame and suspending
+     * doesn't allocate. The coroutine is resumed from the emitting thread,
+     * inside the emission, and receives a copy of the data.
+     *
+     * Destroying the source while a coroutine is suspended on it only
+     * disconnects the awaiter : the coroutine is never resumed and its
+     * frame must be destroyed through its handle, otherwise it leaks.
+     *
+     * @tparam connector_t Function connecting the awaiter to its source.
+     * @tparam args_t Argument types of the source.
+     */
+    template<typename connector_t, typename ... args_t>
+    struct Awaiter : ISlot<args_t...> {
+
+        using result_t = typename detail::AwaitResult<args_t...>::type;
+
+        explicit Awaiter(connector_t inConnector) : mConnector(inConnector) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        template<typename handle_t>
+        void await_suspend(handle_t inHandle);
+
+        result_t await_resume();
+
+        void processSignal(args_t... args) override;
+
+    private:
+        connector_t mConnector;
+        void* mHandle = nullptr;
+        void (*mResume)(void*) = nullptr;
+        std::tuple<std::remove_reference_t<args_t>*...> mArgs;
+    };
+
+
+    template<typename connector_t, typename ... args_t>
+    template<typename handle_t>
+    void Awaiter<connector_t, args_t...>::await_suspend(handle_t inHandle) {
+        mHandle = inHandle.address();
+        mResume = [](void* inAddress) {
+            handle_t::from_address(inAddress).resume();
+        };
+        mConnector(*this);
+    }
+
+    template<typename connector_t, typename ... args_t>
+    typename Awaiter<connector_t, args_t...>::result_t Awaiter<connector_t, args_t...>::await_resume() {
+        if constexpr (sizeof...(args_t) == 1) {
+            return *std::get<0>(mArgs);
+        }
+        else if constexpr (sizeof...(args_t) > 1) {
+            return std::apply(
+                [](auto*... args) {
+                    return result_t(*args...);
+                },
+                mArgs
+            );
+        }
+    }
+
+    template<typename connector_t, typename ... args_t>
+    void Awaiter<connector_t, args_t...>::processSignal(args_t... args) {
+        this->disconnect();
+        // the data stays alive while the coroutine runs until its next
+        // suspension, where await_resume has copied it
+        mArgs = std::make_tuple(&args...);
+        // the coroutine may destroy this awaiter
+        mResume(mHandle);
+    }
+
+}
@@ -27,8 +27,19 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "signal.hpp"
 
+#ifndef USTREAM_PORT_POLICY
+/**
+ * @brief Policy of the broadcast ports, see DefaultSignalPolicy.
+ *
+ * Must be the same in all the translation units.
+ */
+#define USTREAM_PORT_POLICY ustream::DefaultSignalPolicy
+#endif
+
 namespace ustream {
 
     /**
@@ -55,28 +66,193 @@ namespace ustream {
     /**
      * @brief Broadcast data at a given address.
      *
+     * When the arguments are values or const references, the data is
+     * broadcast both to the slots taking them by value and to the slots
+     * taking them by const reference, the latter receiving the data without
+     * any copy.
+     *
      * @tparam address Broadcast address.
      * @tparam args_t Argument types.
      * @param args Data to broadcast.
-     * @return true if at least one slot is connected.
-     * @return false otherwise.
      */
     template<auto address, typename ... args_t>
-    void broadcast(args_t... args);
+    void broadcast(const args_t&... args);
+
+    /**
+     * @brief Broadcast data built on demand at a given address.
+     *
+     * The factory is only called if a slot is open on one of the ports
+     * the data would be broadcast to, and only once.
+     *
+     * @tparam address Broadcast address.
+     * @param inFactory Function returning the data to broadcast.
+     */
+    template<auto address, typename factory_t>
+    void broadcastLazy(factory_t&& inFactory);
+
+    /**
+     * @brief Returns an awaitable resuming a coroutine on the next data
+     * broadcast at the given address.
+     *
+     * A coroutine resumed from the value port of an address and awaiting
+     * the const reference port of the same address receives the same data
+     * again, as the data is broadcast to both ports.
+     *
+     * @tparam address Broadcast address.
+     * @tparam args_t Argument types of the port.
+     * @return Awaitable, see BasicSignal::next.
+     */
+    template<auto address, typename ... args_t>
+    auto receive();
+
+    /**
+     * @brief Calls a function for each broadcast port used by the calling thread.
+     *
+     * Only lists the ports when USTREAM_PORT_POLICY defines an instrumentation.
+     *
+     * @param f Function called with the name and the instrumentation of each port.
+     */
+    template<typename func_t>
+    void forEachPort(func_t&& f);
 
     namespace detail {
 
+        using port_policy_t = USTREAM_PORT_POLICY;
+        using port_instrumentation_t = typename port_policy_t::instrumentation_t;
+
+        template<typename ... args_t>
+        using port_signal_t = BasicSignal<port_policy_t, args_t...>;
+
+        constexpr bool kInstrumentedPorts = !std::is_same_v<port_instrumentation_t, NoInstrumentation>;
+
+        struct PortRecord : ulink::Node<PortRecord> {
+            const char* mName = "";
+            port_instrumentation_t* mInstrumentation = nullptr;
+        };
+
+        inline ulink::List<PortRecord>& portRecords() {
+            thread_local static ulink::List<PortRecord> sRecords;
+            return sRecords;
+        }
+
+        // name made of the address and argument types
         template<auto address, typename ... args_t>
-        Signal<args_t...>& getSignal() {
-            thread_local static Signal<args_t...> sSignal;
-            return sSignal;
+        const char* portName() {
+#if defined(_MSC_VER)
+            return __FUNCSIG__;
+#elif defined(__GNUC__)
+            return __PRETTY_FUNCTION__;
+#else
+            return "";
+#endif
+        }
+
+        // port signal registered in the ports of its thread
+        template<auto address, typename ... args_t>
+        struct RecordedPort {
+            RecordedPort() {
+                mRecord.mName = portName<address, args_t...>();
+                mRecord.mInstrumentation = &mSignal.instrumentation();
+                portRecords().push_front(mRecord);
+            }
+            port_signal_t<args_t...> mSignal;
+            PortRecord mRecord;
+        };
+
+        template<auto address, typename ... args_t>
+        port_signal_t<args_t...>& getSignal() {
+            if constexpr (kInstrumentedPorts) {
+                thread_local static RecordedPort<address, args_t...> sPort;
+                return sPort.mSignal;
+            }
+            else {
+                thread_local static port_signal_t<args_t...> sSignal;
+                return sSignal;
+            }
+        }
+
+        template<typename ... args_t>
+        struct Types {};
+
+        template<auto address, typename ... args_t>
+        port_signal_t<args_t...>& getSignal(Types<args_t...>) {
+            return getSignal<address, args_t...>();
+        }
+
+        template<typename T>
+        constexpr bool isValueOrConstRef =
+            !std::is_reference_v<T> ||
+            (std::is_lvalue_reference_v<T> && std::is_const_v<std::remove_reference_t<T>>);
+
+        template<typename T>
+        using value_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+        // arrays and functions broadcast by value decay to pointers, the
+        // other types, explicit references included, are kept
+        template<typename T>
+        using port_arg_t = std::conditional_t<
+            std::is_array_v<T> || std::is_function_v<T>,
+            std::decay_t<const T>,
+            T
+        >;
+
+        /**
+         * @brief Calls a function with the argument types of each port
+         * receiving the data broadcast as args_t.
+         */
+        template<typename ... args_t, typename func_t>
+        void forEachTargetPort(func_t&& f) {
+
+            using port_t = Types<args_t...>;
+
+            f(port_t());
+
+            if constexpr (sizeof...(args_t) != 0 && (isValueOrConstRef<args_t> && ...)) {
+
+                using value_port_t = Types<value_t<args_t>...>;
+                using ref_port_t = Types<const value_t<args_t>&...>;
+
+                if constexpr (!std::is_same_v<port_t, value_port_t>) {
+                    f(value_port_t());
+                }
+
+                if constexpr (!std::is_same_v<port_t, ref_port_t>) {
+                    f(ref_port_t());
+                }
+            }
         }
 
     }
 
     template<auto address, typename ... args_t>
-    void broadcast(args_t... args) {
-        detail::getSignal<address, args_t...>().emit(args...);
+    void broadcast(const args_t&... args) {
+        detail::forEachTargetPort<detail::port_arg_t<args_t>...>(
+            [&](auto port) {
+                auto& signal = detail::getSignal<address>(port);
+                // most addresses only have slots on one of their ports
+                if (signal.isConnected()) {
+                    signal.emit(args...);
+                }
+            }
+        );
+    }
+
+    template<auto address, typename factory_t>
+    void broadcastLazy(factory_t&& inFactory) {
+
+        using payload_t = std::decay_t<std::invoke_result_t<factory_t&>>;
+
+        bool connected = false;
+
+        detail::forEachTargetPort<payload_t>(
+            [&](auto port) {
+                connected = connected || detail::getSignal<address>(port).isConnected();
+            }
+        );
+
+        if (connected) {
+            broadcast<address>(inFactory());
+        }
     }
 
     template<auto address, typename ... args_t>
@@ -89,4 +265,18 @@ namespace ustream {
         s.disconnect();
     }
 
+    template<auto address, typename ... args_t>
+    auto receive() {
+        return detail::getSignal<address, args_t...>().next();
+    }
+
+    template<typename func_t>
+    void forEachPort(func_t&& f) {
+        if constexpr (detail::kInstrumentedPorts) {
+            for (auto& record : detail::portRecords()) {
+                f(record.mName, *record.mInstrumentation);
+            }
+        }
+    }
+
 }
\ No newline at end of file
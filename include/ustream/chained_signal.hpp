@@ -0,0 +1,228 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <tuple>
+
+#include "signal.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Signal able to forward its emissions to child signals.
+     *
+     * The children are linked into their parent, so an emission calls the
+     * slots of the signal and then emits directly on each child, without
+     * any forwarding slot. A signal has at most one parent and a connection
+     * creating a cycle is refused.
+     *
+     * forEachSlot only visits the slots of this signal, not the ones of
+     * its children.
+     *
+     * @tparam policy_t Signal policy, see DefaultSignalPolicy.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename policy_t, typename ... args_t>
+    struct BasicChainedSignal :
+        BasicSignal<policy_t, args_t...>,
+        ulink::Node<BasicChainedSignal<policy_t, args_t...>> {
+
+        BasicChainedSignal() = default;
+        BasicChainedSignal(const BasicChainedSignal&) = delete;
+
+        ~BasicChainedSignal();
+
+        using BasicSignal<policy_t, args_t...>::connect;
+
+        /**
+         * @brief Connects a child signal to this signal.
+         *
+         * @param inChild Signal receiving the emissions of this signal.
+         * @return true if the connection succeeded
+         * @return false if the child already has a parent or if the
+         * connection would create a cycle.
+         */
+        bool connect(BasicChainedSignal& inChild);
+
+        /**
+         * @brief Disconnects this signal from its parent.
+         */
+        void disconnect();
+
+        /**
+         * @brief Emits data to the connected slots, then to the children.
+         *
+         * @param args data to emit.
+         */
+        void emit(const args_t&... args);
+
+        /**
+         * @brief Emits a batch of data to the connected slots, then to the
+         * children.
+         *
+         * @param batch data to emit.
+         */
+        void emitBatch(Batch<args_t...> batch);
+
+        /**
+         * @brief Emits data built on demand to the connected slots and to
+         * the children.
+         *
+         * The factory is only called if a slot or a child is connected,
+         * and only once.
+         *
+         * @param inFactory Function returning the data to emit.
+         */
+        template<typename factory_t>
+        void emitLazy(factory_t&& inFactory);
+
+        /**
+         * @brief Tells if this signal is connected to at least one slot or
+         * child signal.
+         *
+         * @return true if this signal is connected
+         * @return false otherwise.
+         */
+        bool isConnected() const;
+
+        /**
+         * @brief Returns the parent of this signal.
+         *
+         * @return Parent signal, nullptr if this signal has no parent.
+         */
+        BasicChainedSignal* parent() const { return mParent; }
+
+    private:
+
+        using ulink::Node<BasicChainedSignal<policy_t, args_t...>>::remove;
+
+        template<typename T>
+        friend class ulink::List;
+
+        BasicChainedSignal* mParent = nullptr;
+        ulink::List<BasicChainedSignal> mChildren;
+    };
+
+    /**
+     * @brief Chained signal with the default policy.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename ... args_t>
+    using ChainedSignal = BasicChainedSignal<DefaultSignalPolicy, args_t...>;
+
+
+    template<typename policy_t, typename ... args_t>
+    BasicChainedSignal<policy_t, args_t...>::~BasicChainedSignal() {
+        for (auto& child : mChildren) {
+            child.mParent = nullptr;
+        }
+    }
+
+    template<typename policy_t, typename ... args_t>
+    bool BasicChainedSignal<policy_t, args_t...>::connect(BasicChainedSignal& inChild) {
+
+        if (inChild.isLinked()) {
+            return false;
+        }
+
+        // the child must not be this signal or one of its ancestors
+        for (auto* s = this; s; s = s->mParent) {
+            if (s == &inChild) {
+                return false;
+            }
+        }
+
+        mChildren.push_back(inChild);
+        inChild.mParent = this;
+        return true;
+    }
+
+    template<typename policy_t, typename ... args_t>
+    void BasicChainedSignal<policy_t, args_t...>::disconnect() {
+        remove();
+        mParent = nullptr;
+    }
+
+    template<typename policy_t, typename ... args_t>
+    void BasicChainedSignal<policy_t, args_t...>::emit(const args_t& ... args) {
+
+        BasicSignal<policy_t, args_t...>::emit(args...);
+
+        auto it = mChildren.begin();
+        const auto end = mChildren.end();
+
+        while (it != end) {
+            auto& child = *it;
+            ++it;
+            child.emit(args...);
+        }
+    }
+
+    template<typename policy_t, typename ... args_t>
+    void BasicChainedSignal<policy_t, args_t...>::emitBatch(Batch<args_t...> batch) {
+
+        BasicSignal<policy_t, args_t...>::emitBatch(batch);
+
+        auto it = mChildren.begin();
+        const auto end = mChildren.end();
+
+        while (it != end) {
+            auto& child = *it;
+            ++it;
+            child.emitBatch(batch);
+        }
+    }
+
+    template<typename policy_t, typename ... args_t>
+    template<typename factory_t>
+    void BasicChainedSignal<policy_t, args_t...>::emitLazy(factory_t&& inFactory) {
+
+        if (!isConnected()) {
+            return;
+        }
+
+        if constexpr (sizeof...(args_t) == 1) {
+            emit(inFactory());
+        }
+        else {
+            std::apply(
+                [this](const auto&... args) {
+                    emit(args...);
+                },
+                inFactory()
+            );
+        }
+    }
+
+    template<typename policy_t, typename ... args_t>
+    bool BasicChainedSignal<policy_t, args_t...>::isConnected() const {
+        return BasicSignal<policy_t, args_t...>::isConnected() || !mChildren.empty();
+    }
+
+}
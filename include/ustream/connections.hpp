@@ -0,0 +1,209 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include <type_traits>
+
+#include "islot.hpp"
+#include "signal.hpp"
+#include "broadcast.hpp"
+
+namespace ustream {
+
+    namespace detail {
+
+        // a connection is only tracked by sources linking it : the signals
+        // derived from BasicSignal
+        template<typename policy_t, typename ... args_t>
+        std::true_type linksSlots(const BasicSignal<policy_t, args_t...>*);
+
+        std::false_type linksSlots(const void*);
+
+        template<typename signal_t>
+        constexpr bool isListSignal =
+            decltype(linksSlots(static_cast<const signal_t*>(nullptr)))::value;
+
+    }
+
+    /**
+     * @brief Connections of a slot to several sources.
+     *
+     * Each connection is a node forwarding the data to the target slot, so a
+     * single slot can be connected to N signals or broadcast ports linking
+     * their slots. The connections belong to the caller and are disconnected
+     * on destruction.
+     * The target slot itself stays unlinked and its connected() and
+     * disconnected() callbacks are not called.
+     *
+     * @tparam N Maximum number of connections.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<std::size_t N, typename ... args_t>
+    struct Connections {
+
+        /**
+         * @brief Constructs the connections of a slot.
+         *
+         * @param inTarget Slot receiving the data of all the connections.
+         */
+        explicit Connections(ISlot<args_t...>& inTarget);
+
+        Connections(const Connections&) = delete;
+
+        ~Connections() { disconnect(); }
+
+        /**
+         * @brief Connects the target slot to a signal.
+         *
+         * The signal must link its slots, i.e. derive from BasicSignal.
+         *
+         * @param inSignal Signal to connect to.
+         * @param inConnectArgs Extra arguments of the signal's connect method
+         * such as a priority level.
+         * @return true if the connection succeeded
+         * @return false if all the connections are used or if the signal
+         * refused the connection.
+         */
+        template<typename signal_t, typename ... connect_args_t>
+        bool connect(signal_t& inSignal, connect_args_t&&... inConnectArgs);
+
+        /**
+         * @brief Connects the target slot to a broadcast address.
+         *
+         * @tparam address Broadcast address.
+         * @return true if the connection succeeded
+         * @return false otherwise.
+         */
+        template<auto address>
+        bool open();
+
+        /**
+         * @brief Disconnects all the connections.
+         */
+        void disconnect();
+
+        /**
+         * @brief Returns the number of active connections.
+         *
+         * @return Number of connections.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Returns the maximum number of connections.
+         *
+         * @return Number of connections.
+         */
+        static constexpr std::size_t capacity() { return N; }
+
+    private:
+
+        struct Connection final : ISlot<args_t...> {
+
+            void processSignal(args_t... args) override {
+                mTarget->processSignal(std::forward<args_t>(args)...);
+            }
+
+            void processBatch(Batch<args_t...> batch) override {
+                mTarget->processBatch(batch);
+            }
+
+            ISlot<args_t...>* mTarget = nullptr;
+        };
+
+        Connection* freeConnection();
+
+        Connection mConnections[N];
+    };
+
+
+    template<std::size_t N, typename ... args_t>
+    Connections<N, args_t...>::Connections(ISlot<args_t...>& inTarget) {
+        for (auto& c : mConnections) {
+            c.mTarget = &inTarget;
+        }
+    }
+
+    template<std::size_t N, typename ... args_t>
+    template<typename signal_t, typename ... connect_args_t>
+    bool Connections<N, args_t...>::connect(signal_t& inSignal, connect_args_t&&... inConnectArgs) {
+        static_assert(
+            detail::isListSignal<signal_t>,
+            "Connections requires a signal linking its slots"
+        );
+        auto* c = freeConnection();
+        if (!c) {
+            return false;
+        }
+        return inSignal.connect(*c, std::forward<connect_args_t>(inConnectArgs)...);
+    }
+
+    template<std::size_t N, typename ... args_t>
+    template<auto address>
+    bool Connections<N, args_t...>::open() {
+        auto* c = freeConnection();
+        if (!c) {
+            return false;
+        }
+        return ustream::open<address>(static_cast<ISlot<args_t...>&>(*c));
+    }
+
+    template<std::size_t N, typename ... args_t>
+    void Connections<N, args_t...>::disconnect() {
+        for (auto& c : mConnections) {
+            if (c.isConnected()) {
+                c.disconnect();
+            }
+        }
+    }
+
+    template<std::size_t N, typename ... args_t>
+    std::size_t Connections<N, args_t...>::size() const {
+        std::size_t count = 0;
+        for (const auto& c : mConnections) {
+            if (c.isConnected()) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    template<std::size_t N, typename ... args_t>
+    typename Connections<N, args_t...>::Connection* Connections<N, args_t...>::freeConnection() {
+        for (auto& c : mConnections) {
+            if (!c.isConnected()) {
+                return &c;
+            }
+        }
+        return nullptr;
+    }
+
+}
@@ -0,0 +1,75 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+
+#include "result_signal.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Slot able to consume the data it receives.
+     *
+     * Its processSignal returns true if the data is consumed, the next
+     * consumers won't receive it.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename ... args_t>
+    using IConsumer = IResultSlot<bool, args_t...>;
+
+    /**
+     * @brief Signal stopping at the first consumer consuming the data.
+     *
+     * A result signal folding the results of its consumers with AnyOf.
+     * The consumers are called by priority level, level 0 first, and in
+     * reverse connection order within a level.
+     *
+     * @tparam levels Number of priority levels.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<std::size_t levels, typename ... args_t>
+    struct ConsumableSignal : BasicResultSignal<PrioritySignalPolicy<levels>, bool, args_t...> {
+
+        using BasicResultSignal<PrioritySignalPolicy<levels>, bool, args_t...>::emit;
+
+        /**
+         * @brief Emits data to the connected consumers until one of them
+         * consumes it.
+         *
+         * @param args data to emit.
+         * @return true if the data was consumed
+         * @return false otherwise.
+         */
+        bool emit(const args_t&... args) {
+            return this->emit(AnyOf(), args...);
+        }
+    };
+
+}
@@ -0,0 +1,164 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "islot.hpp"
+
+namespace ustream {
+
+    namespace detail {
+
+        template<typename function_t>
+        struct Signature;
+
+        template<typename ret_t, typename ... args_t>
+        struct Signature<ret_t(*)(args_t...)> {
+            using slot_t = ISlot<args_t...>;
+            using object_t = void;
+        };
+
+        template<typename ret_t, typename ... args_t>
+        struct Signature<ret_t(*)(args_t...) noexcept> : Signature<ret_t(*)(args_t...)> {};
+
+        template<typename ret_t, typename class_t, typename ... args_t>
+        struct Signature<ret_t(class_t::*)(args_t...)> {
+            using slot_t = ISlot<args_t...>;
+            using object_t = class_t;
+        };
+
+        template<typename ret_t, typename class_t, typename ... args_t>
+        struct Signature<ret_t(class_t::*)(args_t...) noexcept> : Signature<ret_t(class_t::*)(args_t...)> {};
+
+        template<typename ret_t, typename class_t, typename ... args_t>
+        struct Signature<ret_t(class_t::*)(args_t...) const> {
+            using slot_t = ISlot<args_t...>;
+            using object_t = const class_t;
+        };
+
+        template<typename ret_t, typename class_t, typename ... args_t>
+        struct Signature<ret_t(class_t::*)(args_t...) const noexcept> : Signature<ret_t(class_t::*)(args_t...) const> {};
+
+        struct NoObject {};
+
+        template<typename object_t>
+        struct DelegateObject {
+            explicit DelegateObject(object_t& inObject) : mObject(&inObject) {}
+            object_t* mObject;
+        };
+
+        template<>
+        struct DelegateObject<void> {};
+
+    }
+
+    /**
+     * @brief Slot calling a function or a member function.
+     *
+     * The function is a template parameter, so the slot's processSignal
+     * calls it directly and can inline it : the emission costs a single
+     * indirect call, and the receiving class doesn't need to derive from
+     * ISlot nor to have virtual methods.
+     * The delegate itself is an ISlot : it keeps the vtable pointer and the
+     * links of any slot, plus the object pointer for a member function, so
+     * it saves a handler class rather than memory.
+     *
+     * @tparam function Free function or member function pointer.
+     */
+    template<auto function, typename = typename detail::Signature<decltype(function)>::slot_t>
+    struct Delegate;
+
+    template<auto function, typename ... args_t>
+    struct Delegate<function, ISlot<args_t...>> final :
+        ISlot<args_t...>,
+        private detail::DelegateObject<typename detail::Signature<decltype(function)>::object_t> {
+
+        using object_t = typename detail::Signature<decltype(function)>::object_t;
+
+        /**
+         * @brief Constructs a delegate to a free function.
+         */
+        Delegate() = default;
+
+        /**
+         * @brief Constructs a delegate to a member function.
+         *
+         * @param inObject Object the member function is called on.
+         */
+        explicit Delegate(std::conditional_t<std::is_void_v<object_t>, detail::NoObject, object_t>& inObject) :
+            detail::DelegateObject<object_t>(inObject) {}
+
+        void processSignal(args_t... args) override {
+            if constexpr (std::is_void_v<object_t>) {
+                function(std::forward<args_t>(args)...);
+            }
+            else {
+                (this->mObject->*function)(std::forward<args_t>(args)...);
+            }
+        }
+    };
+
+    /**
+     * @brief Slot calling a lambda or a function object.
+     *
+     * The callable is stored in the slot and called directly from its
+     * processSignal, which allows the compiler to inline it. The slot is
+     * the size of an ISlot plus the callable's captures.
+     *
+     * @tparam callable_t Callable type with a single call operator.
+     */
+    template<
+        typename callable_t,
+        typename = typename detail::Signature<decltype(&callable_t::operator())>::slot_t
+    >
+    struct CallableSlot;
+
+    template<typename callable_t, typename ... args_t>
+    struct CallableSlot<callable_t, ISlot<args_t...>> final : ISlot<args_t...> {
+
+        /**
+         * @brief Constructs a slot calling a callable.
+         *
+         * @param inCallable Callable to store.
+         */
+        explicit CallableSlot(callable_t inCallable) : mCallable(std::move(inCallable)) {}
+
+        void processSignal(args_t... args) override {
+            mCallable(std::forward<args_t>(args)...);
+        }
+
+    private:
+        callable_t mCallable;
+    };
+
+    template<typename callable_t>
+    CallableSlot(callable_t) -> CallableSlot<callable_t>;
+
+}
@@ -0,0 +1,96 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "executor.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Executor running tasks on the thread that constructed it.
+     *
+     * The tasks can be posted from any thread, and are run when the owner
+     * thread calls poll(), typically from its main loop.
+     */
+    struct EventLoop final : IExecutor {
+
+        EventLoop() : mThread(std::this_thread::get_id()) {}
+
+        EventLoop(const EventLoop&) = delete;
+
+        void post(Task& inTask) override {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTasks.push(inTask);
+        }
+
+        std::size_t concurrency() const override { return 1; }
+
+        bool isCurrent() const override { return std::this_thread::get_id() == mThread; }
+
+        /**
+         * @brief Runs the queued tasks.
+         *
+         * Must be called by the owner thread. The tasks posted while
+         * polling are run by the next call.
+         *
+         * @return Number of tasks run.
+         */
+        std::size_t poll();
+
+    private:
+        const std::thread::id mThread;
+        std::mutex mMutex;
+        detail::TaskQueue mTasks;
+    };
+
+
+    inline std::size_t EventLoop::poll() {
+
+        detail::TaskQueue tasks;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::swap(tasks, mTasks);
+        }
+
+        std::size_t count = 0;
+
+        while (Task* task = tasks.pop()) {
+            task->run();
+            count++;
+        }
+
+        return count;
+    }
+
+}
@@ -0,0 +1,125 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace ustream {
+
+    /**
+     * @brief Unit of work run by an executor.
+     *
+     * Tasks are owned by the caller and linked into the executor queues, so
+     * a task must stay alive until it has run and can only be posted again
+     * once it has started running.
+     */
+    struct Task {
+        Task(const Task&) = delete;
+        Task() = default;
+        virtual ~Task() = default;
+
+        /**
+         * @brief Called by the executor.
+         */
+        virtual void run() = 0;
+
+        /**
+         * @brief Link used by the executor queues.
+         */
+        std::atomic<Task*> mNext { nullptr };
+    };
+
+    /**
+     * @brief Executor running tasks.
+     */
+    struct IExecutor {
+
+        /**
+         * @brief Queues a task for execution.
+         *
+         * @param inTask Task to run.
+         */
+        virtual void post(Task& inTask) = 0;
+
+        /**
+         * @brief Returns the number of tasks the executor can run in parallel.
+         *
+         * @return Number of tasks.
+         */
+        virtual std::size_t concurrency() const = 0;
+
+        /**
+         * @brief Tells if the calling thread is one of the executor's threads.
+         *
+         * @return true if the calling thread runs the executor's tasks
+         * @return false otherwise.
+         */
+        virtual bool isCurrent() const = 0;
+
+    protected:
+        ~IExecutor() = default;
+    };
+
+    namespace detail {
+
+        // task queue protected by the executor
+        struct TaskQueue {
+
+            void push(Task& inTask) {
+                inTask.mNext.store(nullptr, std::memory_order_relaxed);
+                if (mTail) {
+                    mTail->mNext.store(&inTask, std::memory_order_relaxed);
+                }
+                else {
+                    mHead = &inTask;
+                }
+                mTail = &inTask;
+            }
+
+            Task* pop() {
+                Task* task = mHead;
+                if (task) {
+                    mHead = task->mNext.load(std::memory_order_relaxed);
+                    if (!mHead) {
+                        mTail = nullptr;
+                    }
+                }
+                return task;
+            }
+
+            bool empty() const { return !mHead; }
+
+        private:
+            Task* mHead = nullptr;
+            Task* mTail = nullptr;
+        };
+
+    }
+
+}
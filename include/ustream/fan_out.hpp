@@ -0,0 +1,211 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+
+#include "signal.hpp"
+#include "executor.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Emits data to the slots of a signal in parallel.
+     *
+     * The connected slots are gathered, then worker tasks posted to an
+     * executor claim them one by one, so a slow slot doesn't hold back the
+     * others. The data is shared by reference between the workers, it is
+     * never copied. The slots are called concurrently and must not
+     * connect or disconnect slots of the signal.
+     *
+     * @tparam N Maximum number of slots called in parallel, the extra slots
+     * are called by the emitting thread.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<std::size_t N, typename ... args_t>
+    struct FanOut {
+
+        FanOut();
+
+        FanOut(const FanOut&) = delete;
+
+        ~FanOut() { wait(); }
+
+        /**
+         * @brief Emits data in parallel and waits for all the slots to return.
+         *
+         * The calling thread processes slots as well.
+         *
+         * @param inExecutor Executor running the workers.
+         * @param inSignal Signal whose slots are called.
+         * @param args data to emit.
+         */
+        template<typename policy_t>
+        void emit(IExecutor& inExecutor, BasicSignal<policy_t, args_t...>& inSignal, const args_t&... args);
+
+        /**
+         * @brief Starts emitting data in parallel and returns immediately.
+         *
+         * The data and the signal's slots must stay alive until wait()
+         * returns.
+         *
+         * @param inExecutor Executor running the workers.
+         * @param inSignal Signal whose slots are called.
+         * @param args data to emit.
+         */
+        template<typename policy_t>
+        void start(IExecutor& inExecutor, BasicSignal<policy_t, args_t...>& inSignal, const args_t&... args);
+
+        /**
+         * @brief Waits for the current emission to complete.
+         */
+        void wait();
+
+    private:
+
+        struct Worker final : Task {
+            void run() override {
+                mFanOut->work();
+                mFanOut->release();
+            }
+            FanOut* mFanOut = nullptr;
+        };
+
+        template<typename policy_t>
+        void launch(IExecutor& inExecutor, BasicSignal<policy_t, args_t...>& inSignal, bool inHelp, const args_t&... args);
+
+        void work();
+
+        void release();
+
+        ISlot<args_t...>* mSlots[N] = {};
+        std::size_t mSize = 0;
+        std::atomic<std::size_t> mNextSlot { 0 };
+        std::tuple<const std::remove_reference_t<args_t>*...> mArgs;
+
+        Worker mWorkers[N];
+        std::size_t mPending = 0;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+    };
+
+
+    template<std::size_t N, typename ... args_t>
+    FanOut<N, args_t...>::FanOut() {
+        for (auto& w : mWorkers) {
+            w.mFanOut = this;
+        }
+    }
+
+    template<std::size_t N, typename ... args_t>
+    template<typename policy_t>
+    void FanOut<N, args_t...>::emit(IExecutor& inExecutor, BasicSignal<policy_t, args_t...>& inSignal, const args_t&... args) {
+        launch(inExecutor, inSignal, true, args...);
+        work();
+        wait();
+    }
+
+    template<std::size_t N, typename ... args_t>
+    template<typename policy_t>
+    void FanOut<N, args_t...>::start(IExecutor& inExecutor, BasicSignal<policy_t, args_t...>& inSignal, const args_t&... args) {
+        launch(inExecutor, inSignal, false, args...);
+    }
+
+    template<std::size_t N, typename ... args_t>
+    void FanOut<N, args_t...>::wait() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] { return mPending == 0; });
+    }
+
+    template<std::size_t N, typename ... args_t>
+    template<typename policy_t>
+    void FanOut<N, args_t...>::launch(IExecutor& inExecutor, BasicSignal<policy_t, args_t...>& inSignal, bool inHelp, const args_t&... args) {
+
+        // the previous emission must be complete
+        wait();
+
+        mSize = 0;
+        mNextSlot.store(0, std::memory_order_relaxed);
+        mArgs = std::make_tuple(&args...);
+
+        inSignal.forEachSlot(
+            [&](ISlot<args_t...>& s) {
+                if (mSize < N) {
+                    mSlots[mSize++] = &s;
+                }
+                else {
+                    s.processSignal(args...);
+                }
+            }
+        );
+
+        // the calling thread counts as a worker when it helps
+        std::size_t workers = inExecutor.concurrency();
+
+        if (inHelp) {
+            workers = mSize ? (workers < mSize - 1 ? workers : mSize - 1) : 0;
+        }
+        else if (workers > mSize) {
+            workers = mSize;
+        }
+
+        mPending = workers;
+
+        for (std::size_t i = 0; i < workers; i++) {
+            inExecutor.post(mWorkers[i]);
+        }
+    }
+
+    template<std::size_t N, typename ... args_t>
+    void FanOut<N, args_t...>::work() {
+        std::size_t i;
+        while ((i = mNextSlot.fetch_add(1, std::memory_order_relaxed)) < mSize) {
+            auto& s = *mSlots[i];
+            std::apply(
+                [&s](const auto*... args) {
+                    s.processSignal(*args...);
+                },
+                mArgs
+            );
+        }
+    }
+
+    template<std::size_t N, typename ... args_t>
+    void FanOut<N, args_t...>::release() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mPending == 0) {
+            mCondition.notify_all();
+        }
+    }
+
+}
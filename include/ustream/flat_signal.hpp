@@ -0,0 +1,268 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+
+namespace ustream {
+
+    template<typename ... args_t>
+    struct IFlatSlot;
+
+    namespace detail {
+
+        // slot array shared by a FlatSignal and its slots, independent of
+        // the signal capacity
+        template<typename ... args_t>
+        struct FlatSlots {
+            void remove(std::size_t inIndex);
+            void move(std::size_t inFrom, std::size_t inTo);
+
+            IFlatSlot<args_t...>** mSlots;
+            std::size_t mSize;
+            // slots below the cursor are not called yet by the running emission
+            std::size_t mCursor;
+        };
+
+    }
+
+    /**
+     * @brief Slot of a FlatSignal.
+     *
+     * The slot keeps its index in the signal array : it can be disconnected
+     * in constant time, from the signal or by itself, and removes itself from
+     * the signal when deleted. It can't be connected to a list based signal.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename ... args_t>
+    struct IFlatSlot {
+        IFlatSlot(const IFlatSlot&) = delete;
+        IFlatSlot() = default;
+        ~IFlatSlot() { unlink(); }
+
+        /**
+         * @brief Disconnects this slot.
+         */
+        void disconnect() {
+            if (unlink()) {
+                this->disconnected();
+            }
+        }
+
+        /**
+         * @brief Tells if this slot is connected to a signal.
+         *
+         * @return true if this slot is connected
+         * @return false otherwise.
+         */
+        bool isConnected() const { return mOwner != nullptr; }
+
+        /**
+         * @brief Called when the slot is connected.
+         */
+        virtual void connected() {}
+
+        /**
+         * @brief Called when the slot is diconnected.
+         */
+        virtual void disconnected() {}
+
+        /**
+         * @brief Called when a connected signal emits data.
+         *
+         * @param args Signal argument(s).
+         */
+        virtual void processSignal(args_t... args) = 0;
+
+    private:
+
+        bool unlink();
+
+        template<std::size_t N, typename ... signal_args_t>
+        friend struct FlatSignal;
+
+        friend struct detail::FlatSlots<args_t...>;
+
+        detail::FlatSlots<args_t...>* mOwner = nullptr;
+        std::size_t mIndex = 0;
+    };
+
+    /**
+     * @brief Signal storing its slots in a contiguous array.
+     *
+     * Unlike Signal, the slots aren't linked to each other : the emission
+     * walks an array of pointers, so the cost with many slots is bound by the
+     * calls rather than by the pointer chasing. Connection and disconnection
+     * take constant time : a disconnection moves the last slot in place of
+     * the removed one, so the slots are called in reverse connection order
+     * only until the first disconnection.
+     *
+     * @tparam N Maximum number of slots.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<std::size_t N, typename ... args_t>
+    struct FlatSignal {
+        FlatSignal(const FlatSignal&) = delete;
+        FlatSignal() = default;
+
+        /**
+         * @brief Leaves the connected slots disconnected.
+         */
+        ~FlatSignal();
+
+        /**
+         * @brief Connects a slot to this signal.
+         *
+         * @param inSlot Slot to connect.
+         * @return true if the connection succeeded
+         * @return false if the slot is already connected or if the signal is full.
+         */
+        bool connect(IFlatSlot<args_t...>& inSlot);
+
+        /**
+         * @brief Disconnects a slot from this signal.
+         *
+         * @param inSlot Slot to disconnect.
+         * @return true if the slot was connected to this signal
+         * @return false otherwise.
+         */
+        bool disconnect(IFlatSlot<args_t...>& inSlot);
+
+        /**
+         * @brief Emits data to the connected slots.
+         *
+         * A slot may disconnect itself or any other slot while processing
+         * the signal, each remaining slot is called once. The slots
+         * connected during the emission are not called.
+         *
+         * @param args data to emit.
+         */
+        void emit(const args_t&... args);
+
+        /**
+         * @brief Tells if this signal is connected to at least one slot.
+         *
+         * @return true if this signal is connected
+         * @return false otherwise.
+         */
+        bool isConnected() const { return mSlots.mSize != 0; }
+
+        /**
+         * @brief Returns the number of connected slots.
+         *
+         * @return Number of connected slots.
+         */
+        std::size_t size() const { return mSlots.mSize; }
+
+        /**
+         * @brief Returns the maximum number of slots.
+         *
+         * @return Maximum number of slots.
+         */
+        static constexpr std::size_t capacity() { return N; }
+
+    private:
+
+        IFlatSlot<args_t...>* mArray[N] = {};
+        detail::FlatSlots<args_t...> mSlots { mArray, 0, 0 };
+    };
+
+
+    template<typename ... args_t>
+    void detail::FlatSlots<args_t...>::remove(std::size_t inIndex) {
+        if (inIndex < mCursor) {
+            // the last slot not called yet fills the hole, and the last slot
+            // takes its place : the slots still to call stay below the cursor
+            --mCursor;
+            move(mCursor, inIndex);
+            move(--mSize, mCursor);
+        }
+        else {
+            move(--mSize, inIndex);
+        }
+    }
+
+    template<typename ... args_t>
+    void detail::FlatSlots<args_t...>::move(std::size_t inFrom, std::size_t inTo) {
+        mSlots[inTo] = mSlots[inFrom];
+        mSlots[inTo]->mIndex = inTo;
+    }
+
+    template<typename ... args_t>
+    bool IFlatSlot<args_t...>::unlink() {
+        if (!mOwner) {
+            return false;
+        }
+        mOwner->remove(mIndex);
+        mOwner = nullptr;
+        return true;
+    }
+
+    template<std::size_t N, typename ... args_t>
+    FlatSignal<N, args_t...>::~FlatSignal() {
+        for (std::size_t i = 0; i < mSlots.mSize; i++) {
+            mArray[i]->mOwner = nullptr;
+        }
+    }
+
+    template<std::size_t N, typename ... args_t>
+    bool FlatSignal<N, args_t...>::connect(IFlatSlot<args_t...>& inSlot) {
+        if (mSlots.mSize == N || inSlot.isConnected()) {
+            return false;
+        }
+        inSlot.mOwner = &mSlots;
+        inSlot.mIndex = mSlots.mSize;
+        mArray[mSlots.mSize++] = &inSlot;
+        inSlot.connected();
+        return true;
+    }
+
+    template<std::size_t N, typename ... args_t>
+    bool FlatSignal<N, args_t...>::disconnect(IFlatSlot<args_t...>& inSlot) {
+        if (inSlot.mOwner != &mSlots) {
+            return false;
+        }
+        inSlot.disconnect();
+        return true;
+    }
+
+    template<std::size_t N, typename ... args_t>
+    void FlatSignal<N, args_t...>::emit(const args_t& ... args) {
+        // reverse walk : the slots above the cursor are already called or
+        // connected during the emission
+        const auto previous = mSlots.mCursor;
+        mSlots.mCursor = mSlots.mSize;
+        while (mSlots.mCursor != 0) {
+            --mSlots.mCursor;
+            mArray[mSlots.mCursor]->processSignal(args...);
+        }
+        mSlots.mCursor = previous;
+    }
+
+}
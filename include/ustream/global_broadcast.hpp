@@ -0,0 +1,116 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "broadcast.hpp"
+#include "shared_signal.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Broadcast ports shared by all the threads.
+     *
+     * Unlike the ports of broadcast.hpp which are local to each thread, a
+     * slot opened at a global address receives the data broadcast at this
+     * address from any thread. Broadcasting is wait-free and slots can be
+     * opened and closed concurrently.
+     */
+    namespace global {
+
+        /**
+         * @brief Open a slot at the given global address.
+         *
+         * @tparam address Port address.
+         * @tparam args_t Argument types.
+         * @param s Slot to connect.
+         * @return true if the connection succeeded
+         * @return false otherwise.
+         */
+        template<auto address, typename ... args_t>
+        bool open(ISharedSlot<args_t...>& s);
+
+        /**
+         * @brief Close a slot.
+         *
+         * Waits for the broadcasts in progress to complete.
+         *
+         * @tparam args_t Argument types.
+         * @param s Slot to close.
+         */
+        template<typename ... args_t>
+        void close(ISharedSlot<args_t...>& s);
+
+        /**
+         * @brief Broadcast data at a given global address.
+         *
+         * @tparam address Port address.
+         * @tparam args_t Argument types.
+         * @param args Data to broadcast.
+         */
+        template<auto address, typename ... args_t>
+        void broadcast(const args_t&... args);
+
+        namespace detail {
+
+            // constant initialized : no guard on access
+            template<auto address, typename ... args_t>
+            inline SharedSignal<args_t...> sSignal;
+
+            template<auto address, typename ... args_t>
+            SharedSignal<args_t...>& getSignal(ustream::detail::Types<args_t...>) {
+                return sSignal<address, args_t...>;
+            }
+
+        }
+
+        template<auto address, typename ... args_t>
+        bool open(ISharedSlot<args_t...>& s) {
+            return detail::sSignal<address, args_t...>.connect(s);
+        }
+
+        template<typename ... args_t>
+        void close(ISharedSlot<args_t...>& s) {
+            s.disconnect();
+        }
+
+        template<auto address, typename ... args_t>
+        void broadcast(const args_t&... args) {
+            ustream::detail::forEachTargetPort<ustream::detail::port_arg_t<args_t>...>(
+                [&](auto port) {
+                    auto& signal = detail::getSignal<address>(port);
+                    // skips the read lock of the ports without slots
+                    if (signal.isConnected()) {
+                        signal.emit(args...);
+                    }
+                }
+            );
+        }
+
+    }
+
+}
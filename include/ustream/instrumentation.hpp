@@ -0,0 +1,129 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "signal.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Instrumentation measuring the activity of a signal.
+     *
+     * Counts the emissions and the slot calls, and measures the time spent
+     * in the slots.
+     *
+     * @tparam chrono_clock_t Clock providing now(), time_point and duration,
+     * a cycle counter can be used on targets without std::chrono clocks.
+     */
+    template<typename chrono_clock_t = std::chrono::steady_clock>
+    struct Instrumentation {
+
+        using duration_t = typename chrono_clock_t::duration;
+        using time_point_t = typename chrono_clock_t::time_point;
+
+        /**
+         * @brief Returns the number of emissions.
+         *
+         * @return Number of emissions.
+         */
+        std::size_t emitCount() const { return mEmitCount; }
+
+        /**
+         * @brief Returns the number of slot calls.
+         *
+         * @return Number of slot calls.
+         */
+        std::size_t slotCallCount() const { return mSlotCallCount; }
+
+        /**
+         * @brief Returns the cumulative time spent in the slots.
+         *
+         * @return Cumulative time.
+         */
+        duration_t totalSlotTime() const { return mTotalSlotTime; }
+
+        /**
+         * @brief Returns the longest time spent in a slot call.
+         *
+         * @return Maximum time.
+         */
+        duration_t maxSlotTime() const { return mMaxSlotTime; }
+
+        /**
+         * @brief Resets the measures.
+         */
+        void reset() {
+            mEmitCount = 0;
+            mSlotCallCount = 0;
+            mTotalSlotTime = duration_t::zero();
+            mMaxSlotTime = duration_t::zero();
+        }
+
+        void onEmit() {
+            mEmitCount++;
+        }
+
+        time_point_t beginSlot() {
+            return chrono_clock_t::now();
+        }
+
+        void endSlot(time_point_t inStart) {
+            const auto d = chrono_clock_t::now() - inStart;
+            mSlotCallCount++;
+            mTotalSlotTime += d;
+            if (d > mMaxSlotTime) {
+                mMaxSlotTime = d;
+            }
+        }
+
+    private:
+        std::size_t mEmitCount = 0;
+        std::size_t mSlotCallCount = 0;
+        duration_t mTotalSlotTime = duration_t::zero();
+        duration_t mMaxSlotTime = duration_t::zero();
+    };
+
+    /**
+     * @brief Signal policy enabling the instrumentation.
+     */
+    struct InstrumentedSignalPolicy : DefaultSignalPolicy {
+        using instrumentation_t = Instrumentation<>;
+    };
+
+    /**
+     * @brief Instrumented signal.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename ... args_t>
+    using InstrumentedSignal = BasicSignal<InstrumentedSignalPolicy, args_t...>;
+
+}
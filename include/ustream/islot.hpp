@@ -27,45 +27,102 @@
 
 #pragma once
 
+#include <tuple>
+#include <type_traits>
+
 #include "ulink.hpp"
+#include "span.hpp"
 
 namespace ustream {
 
-    /**
-     * @brief Slot.
-     *
-     * @tparam args_t Argument types of the signal.
-     */
-    template<typename ... args_t>
-    struct ISlot : ulink::Node<ISlot<args_t...>> {
-        ISlot(const ISlot&) = delete;
-        ISlot() = default;
+    namespace detail {
 
-        /**
-         * @brief Disconnects this slot.
-         */
-        void disconnect() {
-            ulink::Node<ISlot<args_t...>>::remove();
-            this->disconnected();
-        }
+        template<typename T>
+        constexpr bool isMutableRef =
+            std::is_lvalue_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>>;
+
+        template<typename ... args_t>
+        struct BatchElement {
+            // the arguments of each emission gathered in a tuple
+            using tuple_t = std::tuple<std::decay_t<args_t>...>;
+            using type = std::conditional_t<(isMutableRef<args_t> || ...), tuple_t, const tuple_t>;
+        };
+
+        template<typename arg_t>
+        struct BatchElement<arg_t> {
+            using type = std::conditional_t<
+                isMutableRef<arg_t>,
+                std::remove_reference_t<arg_t>,
+                const std::decay_t<arg_t>
+            >;
+        };
 
         /**
-         * @brief Tells if this slot is connected to a signal or broadcast port.
+         * @brief Base of the slots linked by their signal.
+         *
+         * Holds the connection state and callbacks, the slot type declares
+         * the processSignal method called by its signal.
          *
-         * @return true if this slot is connected
-         * @return false otherwise.
+         * @tparam slot_t Slot type deriving from this base.
          */
-        bool isConnected() const { return this->isLinked(); }
+        template<typename slot_t>
+        struct SlotNode : ulink::Node<slot_t> {
+            SlotNode(const SlotNode&) = delete;
+            SlotNode() = default;
 
-        /**
-         * @brief Called when the slot is connected.
-         */
-        virtual void connected() {}
+            /**
+             * @brief Disconnects this slot.
+             */
+            void disconnect() {
+                ulink::Node<slot_t>::remove();
+                this->disconnected();
+            }
 
-        /**
-         * @brief Called when the slot is diconnected.
-         */
-        virtual void disconnected() {}
+            /**
+             * @brief Tells if this slot is connected to a signal or broadcast port.
+             *
+             * @return true if this slot is connected
+             * @return false otherwise.
+             */
+            bool isConnected() const { return this->isLinked(); }
+
+            /**
+             * @brief Called when the slot is connected.
+             */
+            virtual void connected() {}
+
+            /**
+             * @brief Called when the slot is diconnected.
+             */
+            virtual void disconnected() {}
+
+        private:
+
+            using ulink::Node<slot_t>::remove;
+
+            template<typename T>
+            friend class ulink::List;
+
+        };
+
+    }
+
+    /**
+     * @brief Batch of data, the arguments of each emission being gathered
+     * in a tuple when the signal has several arguments.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename ... args_t>
+    using Batch = Span<typename detail::BatchElement<args_t...>::type>;
+
+    /**
+     * @brief Slot.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename ... args_t>
+    struct ISlot : detail::SlotNode<ISlot<args_t...>> {
 
         /**
          * @brief Called when a connected signal emits data.
@@ -74,13 +131,33 @@ namespace ustream {
          */
         virtual void processSignal(args_t... args) = 0;
 
-    private:
-
-        using ulink::Node<ISlot<args_t...>>::remove;
+        /**
+         * @brief Called when a connected signal emits a batch of data.
+         *
+         * Calls processSignal for each element by default, override it to
+         * process the whole batch at once.
+         *
+         * @param batch Emitted data.
+         */
+        virtual void processBatch(Batch<args_t...> batch);
+    };
 
-        template<typename T>
-        friend class ulink::List;
 
-    };
+    template<typename ... args_t>
+    void ISlot<args_t...>::processBatch(Batch<args_t...> batch) {
+        for (auto& element : batch) {
+            if constexpr (sizeof...(args_t) == 1) {
+                processSignal(element);
+            }
+            else {
+                std::apply(
+                    [this](auto&... args) {
+                        processSignal(args...);
+                    },
+                    element
+                );
+            }
+        }
+    }
 
 }
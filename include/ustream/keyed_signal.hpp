@@ -0,0 +1,182 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "islot.hpp"
+
+namespace ustream {
+
+    template<typename key_t, std::size_t N, typename ... args_t>
+    struct KeyedSignal;
+
+    /**
+     * @brief Slot subscribing to a key of a keyed signal.
+     *
+     * @tparam key_t Key type.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename key_t, typename ... args_t>
+    struct KeyedSlot : ISlot<args_t...> {
+
+        /**
+         * @brief Constructs a keyed slot.
+         *
+         * @param inKey Key of the data to receive.
+         */
+        explicit KeyedSlot(const key_t& inKey) : mKey(inKey) {}
+
+        /**
+         * @brief Returns the key of this slot.
+         *
+         * @return Key.
+         */
+        const key_t& key() const { return mKey; }
+
+        /**
+         * @brief Changes the key of this slot.
+         *
+         * @param inKey New key.
+         * @return true if the key was changed
+         * @return false if the slot is connected.
+         */
+        bool setKey(const key_t& inKey) {
+            if (this->isConnected()) {
+                return false;
+            }
+            mKey = inKey;
+            return true;
+        }
+
+    private:
+        key_t mKey;
+    };
+
+    /**
+     * @brief Signal emitting to the slots of a given key.
+     *
+     * The slots are sorted in N buckets indexed by their key, so an emission
+     * only walks the slots of one bucket. With integral or enum keys lower
+     * than N, each bucket holds a single key and no slot is skipped.
+     *
+     * @tparam key_t Key type, integral, enum or hashable with std::hash.
+     * @tparam N Number of buckets.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename key_t, std::size_t N, typename ... args_t>
+    struct KeyedSignal {
+
+        static_assert(N != 0, "bucket count must not be zero");
+
+        using slot_t = KeyedSlot<key_t, args_t...>;
+
+        /**
+         * @brief Connects a slot to this signal.
+         *
+         * @param inSlot Slot to connect.
+         * @return true if the connection succeeded
+         * @return false otherwise.
+         */
+        bool connect(slot_t& inSlot);
+
+        /**
+         * @brief Emits data to the slots subscribed to a key.
+         *
+         * @param inKey Key of the data.
+         * @param args data to emit.
+         */
+        void emit(const key_t& inKey, const args_t&... args);
+
+        /**
+         * @brief Tells if at least one slot is subscribed to a key.
+         *
+         * @param inKey Key to check.
+         * @return true if a slot is subscribed to the key
+         * @return false otherwise.
+         */
+        bool isConnected(const key_t& inKey);
+
+    private:
+
+        static std::size_t index(const key_t& inKey);
+
+        ulink::List<ISlot<args_t...>> mBuckets[N];
+    };
+
+
+    template<typename key_t, std::size_t N, typename ... args_t>
+    bool KeyedSignal<key_t, N, args_t...>::connect(slot_t& inSlot) {
+        if (inSlot.isLinked()) {
+            return false;
+        }
+        mBuckets[index(inSlot.key())].push_front(inSlot);
+        inSlot.connected();
+        return true;
+    }
+
+    template<typename key_t, std::size_t N, typename ... args_t>
+    void KeyedSignal<key_t, N, args_t...>::emit(const key_t& inKey, const args_t& ... args) {
+
+        auto& bucket = mBuckets[index(inKey)];
+
+        auto it = bucket.begin();
+        const auto end = bucket.end();
+
+        while (it != end) {
+            auto& s = static_cast<slot_t&>(*it);
+            ++it;
+            if (s.key() == inKey) {
+                s.processSignal(args...);
+            }
+        }
+    }
+
+    template<typename key_t, std::size_t N, typename ... args_t>
+    bool KeyedSignal<key_t, N, args_t...>::isConnected(const key_t& inKey) {
+        for (auto& s : mBuckets[index(inKey)]) {
+            if (static_cast<slot_t&>(s).key() == inKey) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename key_t, std::size_t N, typename ... args_t>
+    std::size_t KeyedSignal<key_t, N, args_t...>::index(const key_t& inKey) {
+        if constexpr (std::is_integral_v<key_t> || std::is_enum_v<key_t>) {
+            return static_cast<std::size_t>(inKey) % N;
+        }
+        else {
+            return std::hash<key_t>()(inKey) % N;
+        }
+    }
+
+}
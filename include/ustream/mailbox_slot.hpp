@@ -0,0 +1,141 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+
+#include "islot.hpp"
+#include "shared_signal.hpp"
+#include "mpsc_ring.hpp"
+#include "queued_slot.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Slot receiving data from several threads for one consumer thread.
+     *
+     * Any number of producers can emit concurrently to this slot through a
+     * SharedSignal or a global broadcast port : the data is pushed into a
+     * fixed size lock-free queue, and the consumer thread passes it to the
+     * target slot in batches with drain().
+     *
+     * @tparam N Mailbox capacity, must be a power of two.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<std::size_t N, typename ... args_t>
+    struct MailboxSlot : ISharedSlot<args_t...> {
+
+        /**
+         * @brief Constructs a mailbox slot.
+         *
+         * @param inTarget Slot called by the consumer thread.
+         */
+        MailboxSlot(ISlot<args_t...>& inTarget) : mTarget(inTarget) {}
+
+        ~MailboxSlot() {
+            this->disconnect();
+        }
+
+        /**
+         * @brief Queues the data, called by the emitting threads.
+         *
+         * The data is dropped if the mailbox is full.
+         *
+         * @param args Signal argument(s).
+         */
+        void processSignal(args_t... args) override;
+
+        /**
+         * @brief Queues the data, callable by any thread.
+         *
+         * Lets a producer know if its own data was queued, unlike
+         * dropped() which counts the drops of all the producers.
+         *
+         * @param args Data to queue.
+         * @return true if the data was queued
+         * @return false if the mailbox is full, the data is dropped.
+         */
+        bool push(args_t... args);
+
+        /**
+         * @brief Passes queued data to the target slot.
+         *
+         * Must be called by the consumer thread.
+         *
+         * @param inMaxCount Maximum number of data to process.
+         * @return Number of processed data.
+         */
+        std::size_t drain(std::size_t inMaxCount = N);
+
+        /**
+         * @brief Returns the number of data dropped because the mailbox was full.
+         *
+         * @return Number of dropped data.
+         */
+        std::size_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+    private:
+        using payload_t = detail::queued_t<args_t...>;
+
+        ISlot<args_t...>& mTarget;
+        MPSCRing<payload_t, N> mQueue;
+        std::atomic<std::size_t> mDropped { 0 };
+    };
+
+
+    template<std::size_t N, typename ... args_t>
+    void MailboxSlot<N, args_t...>::processSignal(args_t... args) {
+        push(std::forward<args_t>(args)...);
+    }
+
+    template<std::size_t N, typename ... args_t>
+    bool MailboxSlot<N, args_t...>::push(args_t... args) {
+        if (!mQueue.push(std::forward<args_t>(args)...)) {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    template<std::size_t N, typename ... args_t>
+    std::size_t MailboxSlot<N, args_t...>::drain(std::size_t inMaxCount) {
+        std::size_t count = 0;
+        while (
+            count != inMaxCount &&
+            mQueue.pop(
+                [this](payload_t& payload) {
+                    detail::processQueued<args_t...>(mTarget, payload);
+                }
+            )
+        ) {
+            count++;
+        }
+        return count;
+    }
+
+}
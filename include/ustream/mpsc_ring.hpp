@@ -0,0 +1,163 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "spsc_ring.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Lock-free multiple producers single consumer ring buffer.
+     *
+     * Each cell carries a sequence number telling whether it is free or
+     * holds data, so producers only contend on the reservation of a cell.
+     * The elements are stored in the ring itself, no heap allocation is made.
+     *
+     * @tparam T Element type.
+     * @tparam N Capacity, must be a power of two.
+     */
+    template<typename T, std::size_t N>
+    struct MPSCRing {
+
+        // the indexes wrap around
+        static_assert(N != 0 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+        MPSCRing();
+        MPSCRing(const MPSCRing&) = delete;
+
+        ~MPSCRing() {
+            while (pop([](T&) {}));
+        }
+
+        /**
+         * @brief Constructs an element at the end of the ring.
+         *
+         * Can be called concurrently by any number of producers.
+         *
+         * @param args Element constructor arguments.
+         * @return true if the element was pushed
+         * @return false if the ring is full.
+         */
+        template<typename ... ctor_args_t>
+        bool push(ctor_args_t&&... args);
+
+        /**
+         * @brief Passes the first element of the ring to a function and removes it.
+         *
+         * Must only be called by the consumer.
+         *
+         * @param f Function called with a reference to the element.
+         * @return true if an element was popped
+         * @return false if the ring is empty.
+         */
+        template<typename func_t>
+        bool pop(func_t&& f);
+
+        /**
+         * @brief Returns the capacity of the ring.
+         *
+         * @return Capacity.
+         */
+        static constexpr std::size_t capacity() { return N; }
+
+    private:
+
+        struct Cell {
+            std::atomic<std::size_t> mSequence;
+            alignas(T) unsigned char mData[sizeof(T)];
+        };
+
+        // written by the producers
+        alignas(USTREAM_CACHE_LINE_SIZE) std::atomic<std::size_t> mTail { 0 };
+        // written by the consumer
+        alignas(USTREAM_CACHE_LINE_SIZE) std::size_t mHead = 0;
+
+        alignas(USTREAM_CACHE_LINE_SIZE) Cell mCells[N];
+    };
+
+
+    template<typename T, std::size_t N>
+    MPSCRing<T, N>::MPSCRing() {
+        for (std::size_t i = 0; i < N; i++) {
+            mCells[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename T, std::size_t N>
+    template<typename ... ctor_args_t>
+    bool MPSCRing<T, N>::push(ctor_args_t&&... args) {
+
+        auto tail = mTail.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true) {
+            cell = &mCells[tail % N];
+            const auto sequence = cell->mSequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - tail);
+            if (diff == 0) {
+                // the cell is free : try to reserve it
+                if (mTail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                // the cell still holds data pushed one lap ago
+                return false;
+            }
+            else {
+                // another producer reserved the cell
+                tail = mTail.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->mData) T(std::forward<ctor_args_t>(args)...);
+        cell->mSequence.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T, std::size_t N>
+    template<typename func_t>
+    bool MPSCRing<T, N>::pop(func_t&& f) {
+        Cell& cell = mCells[mHead % N];
+        if (cell.mSequence.load(std::memory_order_acquire) != mHead + 1) {
+            return false;
+        }
+        T* element = std::launder(reinterpret_cast<T*>(cell.mData));
+        f(*element);
+        element->~T();
+        cell.mSequence.store(mHead + N, std::memory_order_release);
+        mHead++;
+        return true;
+    }
+
+}
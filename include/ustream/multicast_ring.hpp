@@ -0,0 +1,331 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "islot.hpp"
+#include "spsc_ring.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Wait strategy spinning until the condition is met.
+     *
+     * Lowest latency, but keeps a core busy while waiting.
+     */
+    struct SpinWait {
+        template<typename pred_t>
+        void wait(pred_t&& inReady) {
+            while (!inReady());
+        }
+
+        void notify() {}
+    };
+
+    /**
+     * @brief Wait strategy yielding the thread until the condition is met.
+     */
+    struct YieldWait {
+        template<typename pred_t>
+        void wait(pred_t&& inReady) {
+            while (!inReady()) {
+                std::this_thread::yield();
+            }
+        }
+
+        void notify() {}
+    };
+
+    /**
+     * @brief Wait strategy blocking the thread until the condition is met.
+     *
+     * The waiting threads sleep on a condition variable, the notifying
+     * threads only take the lock when a thread is waiting.
+     */
+    struct BlockWait {
+        template<typename pred_t>
+        void wait(pred_t&& inReady) {
+            if (inReady()) {
+                return;
+            }
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWaiters.fetch_add(1);
+            // orders the waiter count before the condition check, see notify()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            mCondition.wait(lock, inReady);
+            mWaiters.fetch_sub(1);
+        }
+
+        void notify() {
+            // orders the notified change before the waiter count
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (mWaiters.load() != 0) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mCondition.notify_all();
+            }
+        }
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::atomic<std::size_t> mWaiters { 0 };
+    };
+
+    /**
+     * @brief Ring buffer delivering each element to several consumers.
+     *
+     * The producer writes each element once in the ring, then every
+     * consumer reads it in place, on its own thread and at its own pace,
+     * by advancing its own sequence cursor. The producer waits for the
+     * slowest consumer when the ring is full.
+     *
+     * The ring is a slot : connected to a signal, it publishes the emitted
+     * data. The consumers pass the elements to their target slot, by
+     * reference or as a copy for a slot taking the element by value.
+     *
+     * @tparam T Element type, default constructible and copy assignable.
+     * @tparam N Capacity, must be a power of two.
+     * @tparam consumers Maximum number of consumers.
+     * @tparam wait_t Wait strategy : SpinWait, YieldWait or BlockWait.
+     */
+    template<typename T, std::size_t N, std::size_t consumers, typename wait_t = YieldWait>
+    struct MulticastRing : ISlot<const T&> {
+
+        // the sequences wrap around
+        static_assert(N != 0 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+        /**
+         * @brief Consumer of the ring, owned by the caller.
+         */
+        struct Consumer {
+
+            /**
+             * @brief Constructs a consumer reading the elements in place.
+             *
+             * @param inTarget Slot receiving the elements.
+             */
+            explicit Consumer(ISlot<const T&>& inTarget) : mRefTarget(&inTarget) {}
+
+            /**
+             * @brief Constructs a consumer passing a copy of the elements.
+             *
+             * @param inTarget Slot receiving the elements.
+             */
+            explicit Consumer(ISlot<T>& inTarget) : mValueTarget(&inTarget) {}
+
+            Consumer(const Consumer&) = delete;
+
+            /**
+             * @brief Passes the available elements to the target slot.
+             *
+             * Must be called by the consumer thread.
+             *
+             * @return Number of processed elements.
+             */
+            std::size_t poll();
+
+            /**
+             * @brief Waits for elements and passes them to the target slot.
+             *
+             * Must be called by the consumer thread.
+             *
+             * @return Number of processed elements, 0 if the ring is closed.
+             */
+            std::size_t wait();
+
+        private:
+            friend struct MulticastRing;
+
+            void process(const T& inData);
+
+            // only one of the targets is set
+            ISlot<const T&>* mRefTarget = nullptr;
+            ISlot<T>* mValueTarget = nullptr;
+            MulticastRing* mRing = nullptr;
+            // number of elements read, written by the consumer thread
+            alignas(USTREAM_CACHE_LINE_SIZE) std::atomic<std::size_t> mCursor { 0 };
+        };
+
+        MulticastRing() = default;
+
+        MulticastRing(const MulticastRing&) = delete;
+
+        /**
+         * @brief Attaches a consumer to the ring.
+         *
+         * Must be called before the producer starts, or by the producer
+         * thread. The consumer receives the elements published after this
+         * call.
+         *
+         * @param inConsumer Consumer to attach.
+         * @return true if the consumer was attached
+         * @return false if the ring has no room for another consumer or if
+         * the consumer is already attached.
+         */
+        bool attach(Consumer& inConsumer);
+
+        /**
+         * @brief Publishes an element, called by the producer thread.
+         *
+         * Waits for the slowest consumer when the ring is full.
+         *
+         * @param inData Element to publish.
+         */
+        void processSignal(const T& inData) override;
+
+        /**
+         * @brief Closes the ring, waking up the waiting consumers.
+         *
+         * The consumers still receive the elements published before.
+         */
+        void close();
+
+        /**
+         * @brief Returns the capacity of the ring.
+         *
+         * @return Capacity.
+         */
+        static constexpr std::size_t capacity() { return N; }
+
+    private:
+
+        // lowest consumer cursor, the producer sequence if no consumer
+        std::size_t minCursor(std::size_t inSequence) const;
+
+        wait_t mWait;
+        Consumer* mConsumers[consumers] = {};
+        std::atomic<std::size_t> mConsumerCount { 0 };
+        std::atomic<bool> mClosed { false };
+        // cursor of the slowest consumer when last checked, producer only
+        std::size_t mGate = 0;
+        // number of published elements, written by the producer
+        alignas(USTREAM_CACHE_LINE_SIZE) std::atomic<std::size_t> mPublished { 0 };
+        alignas(USTREAM_CACHE_LINE_SIZE) T mCells[N];
+    };
+
+
+    template<typename T, std::size_t N, std::size_t consumers, typename wait_t>
+    bool MulticastRing<T, N, consumers, wait_t>::attach(Consumer& inConsumer) {
+        const auto count = mConsumerCount.load(std::memory_order_relaxed);
+        if (count == consumers || inConsumer.mRing) {
+            return false;
+        }
+        inConsumer.mRing = this;
+        inConsumer.mCursor.store(mPublished.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        mConsumers[count] = &inConsumer;
+        mConsumerCount.store(count + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T, std::size_t N, std::size_t consumers, typename wait_t>
+    void MulticastRing<T, N, consumers, wait_t>::processSignal(const T& inData) {
+
+        const auto sequence = mPublished.load(std::memory_order_relaxed);
+
+        if (sequence - mGate >= N) {
+            mWait.wait(
+                [&] {
+                    mGate = minCursor(sequence);
+                    return sequence - mGate < N;
+                }
+            );
+        }
+
+        mCells[sequence % N] = inData;
+        mPublished.store(sequence + 1, std::memory_order_release);
+        mWait.notify();
+    }
+
+    template<typename T, std::size_t N, std::size_t consumers, typename wait_t>
+    void MulticastRing<T, N, consumers, wait_t>::close() {
+        mClosed.store(true, std::memory_order_release);
+        mWait.notify();
+    }
+
+    template<typename T, std::size_t N, std::size_t consumers, typename wait_t>
+    std::size_t MulticastRing<T, N, consumers, wait_t>::minCursor(std::size_t inSequence) const {
+        auto min = inSequence;
+        const auto count = mConsumerCount.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; i++) {
+            const auto cursor = mConsumers[i]->mCursor.load(std::memory_order_acquire);
+            // compared as distances to support the wrap around
+            if (inSequence - cursor > inSequence - min) {
+                min = cursor;
+            }
+        }
+        return min;
+    }
+
+    template<typename T, std::size_t N, std::size_t consumers, typename wait_t>
+    std::size_t MulticastRing<T, N, consumers, wait_t>::Consumer::poll() {
+
+        const auto cursor = mCursor.load(std::memory_order_relaxed);
+        const auto published = mRing->mPublished.load(std::memory_order_acquire);
+
+        for (auto s = cursor; s != published; s++) {
+            process(mRing->mCells[s % N]);
+        }
+
+        if (published != cursor) {
+            // releases the cells to the producer
+            mCursor.store(published, std::memory_order_release);
+            mRing->mWait.notify();
+        }
+
+        return published - cursor;
+    }
+
+    template<typename T, std::size_t N, std::size_t consumers, typename wait_t>
+    std::size_t MulticastRing<T, N, consumers, wait_t>::Consumer::wait() {
+        const auto cursor = mCursor.load(std::memory_order_relaxed);
+        mRing->mWait.wait(
+            [&] {
+                return
+                    mRing->mPublished.load(std::memory_order_acquire) != cursor ||
+                    mRing->mClosed.load(std::memory_order_acquire);
+            }
+        );
+        return poll();
+    }
+
+    template<typename T, std::size_t N, std::size_t consumers, typename wait_t>
+    void MulticastRing<T, N, consumers, wait_t>::Consumer::process(const T& inData) {
+        if (mRefTarget) {
+            mRefTarget->processSignal(inData);
+        }
+        else {
+            mValueTarget->processSignal(inData);
+        }
+    }
+
+}
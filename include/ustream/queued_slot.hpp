@@ -0,0 +1,151 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "islot.hpp"
+#include "spsc_ring.hpp"
+
+namespace ustream {
+
+    namespace detail {
+
+        template<typename ... args_t>
+        using queued_t = std::tuple<std::decay_t<args_t>...>;
+
+        // calls a slot with queued data
+        template<typename ... args_t>
+        void processQueued(ISlot<args_t...>& inSlot, queued_t<args_t...>& inData) {
+            std::apply(
+                [&inSlot](auto&... args) {
+                    inSlot.processSignal(std::forward<args_t>(args)...);
+                },
+                inData
+            );
+        }
+
+    }
+
+    /**
+     * @brief Slot queueing the received data for another thread.
+     *
+     * The emitting thread only copies the data in a ring buffer, the target
+     * slot is called later by the consumer thread with drain() or poll().
+     * The data is copied in the queue, so a target slot taking references
+     * receives references to the queued copies.
+     *
+     * @tparam N Queue capacity, must be a power of two.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<std::size_t N, typename ... args_t>
+    struct QueuedSlot : ISlot<args_t...> {
+
+        /**
+         * @brief Constructs a queued slot.
+         *
+         * @param inTarget Slot called by the consumer thread.
+         */
+        QueuedSlot(ISlot<args_t...>& inTarget) : mTarget(inTarget) {}
+
+        /**
+         * @brief Queues the data, called by the emitting thread.
+         *
+         * The data is dropped if the queue is full.
+         *
+         * @param args Signal argument(s).
+         */
+        void processSignal(args_t... args) override;
+
+        /**
+         * @brief Passes the oldest queued data to the target slot.
+         *
+         * Must be called by the consumer thread.
+         *
+         * @return true if data was processed
+         * @return false if the queue was empty.
+         */
+        bool poll();
+
+        /**
+         * @brief Passes the queued data to the target slot.
+         *
+         * Must be called by the consumer thread. At most N data are processed
+         * so that a fast producer can't keep the consumer in this call.
+         *
+         * @return Number of processed data.
+         */
+        std::size_t drain();
+
+        /**
+         * @brief Returns the number of data dropped because the queue was full.
+         *
+         * @return Number of dropped data.
+         */
+        std::size_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+    private:
+        using payload_t = detail::queued_t<args_t...>;
+
+        ISlot<args_t...>& mTarget;
+        SPSCRing<payload_t, N> mQueue;
+        std::atomic<std::size_t> mDropped { 0 };
+    };
+
+
+    template<std::size_t N, typename ... args_t>
+    void QueuedSlot<N, args_t...>::processSignal(args_t... args) {
+        if (!mQueue.push(std::forward<args_t>(args)...)) {
+            // only written by the producer
+            mDropped.store(mDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    template<std::size_t N, typename ... args_t>
+    bool QueuedSlot<N, args_t...>::poll() {
+        return mQueue.pop(
+            [this](payload_t& payload) {
+                detail::processQueued<args_t...>(mTarget, payload);
+            }
+        );
+    }
+
+    template<std::size_t N, typename ... args_t>
+    std::size_t QueuedSlot<N, args_t...>::drain() {
+        std::size_t count = 0;
+        while (count != N && poll()) {
+            count++;
+        }
+        return count;
+    }
+
+}
@@ -0,0 +1,333 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "islot.hpp"
+#include "signal.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Slot returning a result.
+     *
+     * @tparam result_t Result type.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename result_t, typename ... args_t>
+    struct IResultSlot : detail::SlotNode<IResultSlot<result_t, args_t...>> {
+
+        /**
+         * @brief Called when a connected signal emits data.
+         *
+         * @param args Signal argument(s).
+         * @return Result passed to the combiner of the emission.
+         */
+        virtual result_t processSignal(args_t... args) = 0;
+    };
+
+    namespace detail {
+
+        template<typename combiner_t, typename = void>
+        struct isCombiner : std::false_type {};
+
+        template<typename combiner_t>
+        struct isCombiner<combiner_t, std::void_t<decltype(std::declval<combiner_t&>().result())>> : std::true_type {};
+
+    }
+
+    /**
+     * @brief Signal collecting the results of its slots.
+     *
+     * A combiner folds the results as the slots are called, it provides :
+     * - bool add(result) : called with each result, returns false to skip
+     *   the remaining slots
+     * - result() : returns the folded value
+     *
+     * The slots are called by priority level and order as for BasicSignal.
+     *
+     * @tparam policy_t Signal policy, see DefaultSignalPolicy.
+     * @tparam result_t Result type of the slots.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename policy_t, typename result_t, typename ... args_t>
+    struct BasicResultSignal : private policy_t::instrumentation_t {
+
+        using slot_t = IResultSlot<result_t, args_t...>;
+
+        using instrumentation_t = typename policy_t::instrumentation_t;
+
+        /**
+         * @brief Connects a slot to this signal.
+         *
+         * @param inSlot Slot to connect.
+         * @param inPriority Priority level, 0 being the highest priority.
+         * @return true if the connection succeeded
+         * @return false otherwise.
+         */
+        bool connect(slot_t& inSlot, std::size_t inPriority = 0);
+
+        /**
+         * @brief Emits data to the connected slots, discarding the results.
+         *
+         * @param args data to emit.
+         */
+        void emit(const args_t&... args);
+
+        /**
+         * @brief Emits data to the connected slots and folds their results.
+         *
+         * @param inCombiner Combiner folding the results, see ResultSignal.
+         * @param args data to emit.
+         * @return The folded value returned by the combiner.
+         */
+        template<typename combiner_t, std::enable_if_t<detail::isCombiner<combiner_t>::value, int> = 0>
+        auto emit(combiner_t&& inCombiner, const args_t&... args);
+
+        /**
+         * @brief Tells if this signal is connected to at least one slot.
+         *
+         * @return true if this signal is connected
+         * @return false otherwise.
+         */
+        bool isConnected() const { return mSlots.isConnected(); }
+
+        /**
+         * @brief Returns the instrumentation of this signal.
+         *
+         * @return Instrumentation.
+         */
+        const instrumentation_t& instrumentation() const { return *this; }
+
+        /**
+         * @brief Returns the instrumentation of this signal.
+         *
+         * @return Instrumentation.
+         */
+        instrumentation_t& instrumentation() { return *this; }
+
+    private:
+        detail::SlotLists<policy_t, slot_t> mSlots;
+    };
+
+    /**
+     * @brief Result signal with the default policy.
+     *
+     * @tparam result_t Result type of the slots.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename result_t, typename ... args_t>
+    using ResultSignal = BasicResultSignal<DefaultSignalPolicy, result_t, args_t...>;
+
+    /**
+     * @brief Combiner keeping the lowest result.
+     *
+     * @tparam T Result type.
+     */
+    template<typename T>
+    struct Min {
+        bool add(const T& inValue) {
+            if (!mResult || inValue < *mResult) {
+                mResult = inValue;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns the lowest result, empty if no slot was called.
+         */
+        const std::optional<T>& result() const { return mResult; }
+
+    private:
+        std::optional<T> mResult;
+    };
+
+    /**
+     * @brief Combiner keeping the highest result.
+     *
+     * @tparam T Result type.
+     */
+    template<typename T>
+    struct Max {
+        bool add(const T& inValue) {
+            if (!mResult || *mResult < inValue) {
+                mResult = inValue;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns the highest result, empty if no slot was called.
+         */
+        const std::optional<T>& result() const { return mResult; }
+
+    private:
+        std::optional<T> mResult;
+    };
+
+    /**
+     * @brief Combiner summing the results.
+     *
+     * @tparam T Result type.
+     */
+    template<typename T>
+    struct Sum {
+        /**
+         * @brief Constructs the combiner.
+         *
+         * @param inInitial Initial value of the sum.
+         */
+        constexpr Sum(T inInitial = T()) : mResult(std::move(inInitial)) {}
+
+        bool add(const T& inValue) {
+            mResult += inValue;
+            return true;
+        }
+
+        /**
+         * @brief Returns the sum of the results.
+         */
+        const T& result() const { return mResult; }
+
+    private:
+        T mResult;
+    };
+
+    /**
+     * @brief Combiner keeping the first non empty result.
+     *
+     * The slots return a std::optional, the remaining slots are skipped
+     * once a slot returns a value.
+     *
+     * @tparam T Value type of the results.
+     */
+    template<typename T>
+    struct FirstNonEmpty {
+        bool add(std::optional<T>&& inValue) {
+            mResult = std::move(inValue);
+            return !mResult;
+        }
+
+        bool add(const std::optional<T>& inValue) {
+            mResult = inValue;
+            return !mResult;
+        }
+
+        /**
+         * @brief Returns the first non empty result, empty if none.
+         */
+        const std::optional<T>& result() const { return mResult; }
+
+    private:
+        std::optional<T> mResult;
+    };
+
+    /**
+     * @brief Combiner checking that all the results are true.
+     *
+     * The remaining slots are skipped once a slot returns false.
+     */
+    struct AllOf {
+        bool add(bool inValue) {
+            mResult = inValue;
+            return mResult;
+        }
+
+        /**
+         * @brief Returns true if all the slots returned true or if no slot
+         * was called.
+         */
+        bool result() const { return mResult; }
+
+    private:
+        bool mResult = true;
+    };
+
+    /**
+     * @brief Combiner checking that a result is true.
+     *
+     * The remaining slots are skipped once a slot returns true.
+     */
+    struct AnyOf {
+        bool add(bool inValue) {
+            mResult = inValue;
+            return !mResult;
+        }
+
+        /**
+         * @brief Returns true if a slot returned true.
+         */
+        bool result() const { return mResult; }
+
+    private:
+        bool mResult = false;
+    };
+
+
+    template<typename policy_t, typename result_t, typename ... args_t>
+    bool BasicResultSignal<policy_t, result_t, args_t...>::connect(slot_t& inSlot, std::size_t inPriority) {
+        return mSlots.connect(inSlot, inPriority);
+    }
+
+    template<typename policy_t, typename result_t, typename ... args_t>
+    void BasicResultSignal<policy_t, result_t, args_t...>::emit(const args_t& ... args) {
+
+        this->onEmit();
+
+        mSlots.forEach(
+            [&](slot_t& s) {
+                const auto token = this->beginSlot();
+                s.processSignal(args...);
+                this->endSlot(token);
+            }
+        );
+    }
+
+    template<typename policy_t, typename result_t, typename ... args_t>
+    template<typename combiner_t, std::enable_if_t<detail::isCombiner<combiner_t>::value, int>>
+    auto BasicResultSignal<policy_t, result_t, args_t...>::emit(combiner_t&& inCombiner, const args_t& ... args) {
+
+        this->onEmit();
+
+        mSlots.forEach(
+            [&](slot_t& s) {
+                const auto token = this->beginSlot();
+                const bool next = inCombiner.add(s.processSignal(args...));
+                this->endSlot(token);
+                return next;
+            }
+        );
+
+        return inCombiner.result();
+    }
+
+}
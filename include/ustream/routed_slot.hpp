@@ -0,0 +1,190 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "islot.hpp"
+#include "executor.hpp"
+#include "mpsc_ring.hpp"
+#include "queued_slot.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Slot calling its target slot on a given executor.
+     *
+     * When the executor is serial (concurrency of 1) and the data is
+     * emitted from its thread, the target slot is called immediately
+     * without any copy. Otherwise the data is copied in a fixed size queue
+     * and a task posted to the executor passes it to the target slot. The
+     * target slot is never called concurrently, in the order the data was
+     * queued. Data emitted from a serial executor's thread can be
+     * processed before data still queued from other threads.
+     *
+     * The slot must outlive the tasks it posted, see idle().
+     *
+     * @tparam N Queue capacity, must be a power of two.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<std::size_t N, typename ... args_t>
+    struct RoutedSlot : ISlot<args_t...> {
+
+        /**
+         * @brief Constructs a routed slot.
+         *
+         * @param inTarget Slot called on the executor.
+         * @param inExecutor Executor running the target slot.
+         */
+        RoutedSlot(ISlot<args_t...>& inTarget, IExecutor& inExecutor);
+
+        /**
+         * @brief Calls the target slot or queues the data for the executor.
+         *
+         * The data is dropped if the queue is full.
+         *
+         * @param args Signal argument(s).
+         */
+        void processSignal(args_t... args) override;
+
+        /**
+         * @brief Returns the number of dropped data.
+         *
+         * @return Number of dropped data.
+         */
+        std::size_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Tells if no task of this slot is posted or running.
+         *
+         * Once disconnected, the slot can be destroyed when idle.
+         *
+         * @return true if the slot is idle
+         * @return false otherwise.
+         */
+        bool idle() const {
+            return !mScheduled.load() && mRunning.load() == 0;
+        }
+
+    private:
+
+        struct Drain final : Task {
+            void run() override {
+                mSlot->mRunning.fetch_add(1);
+                mSlot->drain();
+                // last access to the slot
+                mSlot->mRunning.fetch_sub(1);
+            }
+            RoutedSlot* mSlot = nullptr;
+        };
+
+        void drain();
+
+        using payload_t = detail::queued_t<args_t...>;
+
+        ISlot<args_t...>& mTarget;
+        IExecutor& mExecutor;
+        MPSCRing<payload_t, N> mQueue;
+        Drain mDrain;
+        // true from the posting of the drain task until the queue is empty
+        std::atomic<bool> mScheduled { false };
+        // number of drain tasks running, a new one can start before the
+        // previous one returns
+        std::atomic<std::size_t> mRunning { 0 };
+        // data pushed and popped, readable by any thread unlike the queue
+        std::atomic<std::size_t> mPushed { 0 };
+        std::atomic<std::size_t> mPopped { 0 };
+        std::atomic<std::size_t> mDropped { 0 };
+    };
+
+
+    template<std::size_t N, typename ... args_t>
+    RoutedSlot<N, args_t...>::RoutedSlot(ISlot<args_t...>& inTarget, IExecutor& inExecutor) :
+        mTarget(inTarget),
+        mExecutor(inExecutor) {
+        mDrain.mSlot = this;
+    }
+
+    template<std::size_t N, typename ... args_t>
+    void RoutedSlot<N, args_t...>::processSignal(args_t... args) {
+
+        // a thread of a parallel executor could run concurrently with
+        // another one or with the drain task
+        if (mExecutor.concurrency() == 1 && mExecutor.isCurrent()) {
+            mTarget.processSignal(std::forward<args_t>(args)...);
+            return;
+        }
+
+        if (!mQueue.push(std::forward<args_t>(args)...)) {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        mPushed.fetch_add(1);
+
+        // orders the push before the flag, see drain()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!mScheduled.exchange(true)) {
+            mExecutor.post(mDrain);
+        }
+    }
+
+    template<std::size_t N, typename ... args_t>
+    void RoutedSlot<N, args_t...>::drain() {
+
+        std::size_t popped;
+
+        do {
+            // another drain task may have run since the flag was cleared
+            popped = mPopped.load();
+
+            while (
+                mQueue.pop(
+                    [this](payload_t& payload) {
+                        detail::processQueued<args_t...>(mTarget, payload);
+                    }
+                )
+            ) {
+                mPopped.store(++popped);
+            }
+
+            mScheduled.store(false);
+
+            // data counted before the flag was cleared didn't post a task :
+            // process it now unless another producer already posted one.
+            // The queue belongs to the new drain task once the flag is
+            // cleared, so only the counters are read here.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        } while (mPushed.load() > popped && !mScheduled.exchange(true));
+    }
+
+}
@@ -0,0 +1,308 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace ustream {
+
+    template<typename ... args_t>
+    struct SharedSignal;
+
+    /**
+     * @brief Slot that can be connected to a signal shared between threads.
+     *
+     * Disconnecting waits for the emissions in progress on other threads, so
+     * the slot isn't called anymore once disconnect() returns. As the slot
+     * may be called until then, the most derived class should disconnect
+     * the slot first thing in its destructor.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename ... args_t>
+    struct ISharedSlot {
+        ISharedSlot(const ISharedSlot&) = delete;
+        ISharedSlot() = default;
+
+        virtual ~ISharedSlot() { disconnect(); }
+
+        /**
+         * @brief Disconnects this slot.
+         *
+         * Must not be called from processSignal.
+         */
+        void disconnect();
+
+        /**
+         * @brief Tells if this slot is connected to a shared signal or broadcast port.
+         *
+         * @return true if this slot is connected
+         * @return false otherwise.
+         */
+        bool isConnected() const { return mSignal.load() != nullptr; }
+
+        /**
+         * @brief Called when the slot is connected.
+         */
+        virtual void connected() {}
+
+        /**
+         * @brief Called when the slot is diconnected.
+         */
+        virtual void disconnected() {}
+
+        /**
+         * @brief Called when a connected signal emits data.
+         *
+         * May be called concurrently from several threads.
+         *
+         * @param args Signal argument(s).
+         */
+        virtual void processSignal(args_t... args) = 0;
+
+    private:
+        // next slot, the lowest bit is set when this slot is being removed
+        std::atomic<std::uintptr_t> mNext { 0 };
+        std::atomic<SharedSignal<args_t...>*> mSignal { nullptr };
+
+        friend struct SharedSignal<args_t...>;
+    };
+
+    /**
+     * @brief Signal that can be used from several threads.
+     *
+     * The emission is wait-free and the connection and disconnection are
+     * lock-free : they never wait for each other. A slot being disconnected
+     * is removed from the list right away, then the disconnection waits for
+     * the emissions that may still see it to complete.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename ... args_t>
+    struct SharedSignal {
+
+        constexpr SharedSignal() = default;
+        SharedSignal(const SharedSignal&) = delete;
+
+        ~SharedSignal();
+
+        /**
+         * @brief Connects a slot to this signal.
+         *
+         * @param inSlot Slot to connect.
+         * @return true if the connection succeeded
+         * @return false otherwise.
+         */
+        bool connect(ISharedSlot<args_t...>& inSlot);
+
+        /**
+         * @brief Emits data to the connected slots.
+         *
+         * @param args data to emit.
+         */
+        void emit(const args_t&... args);
+
+        /**
+         * @brief Tells if this signal is connected to at least one slot.
+         *
+         * @return true if this signal is connected
+         * @return false otherwise.
+         */
+        bool isConnected() const { return mSlots.load() != 0; }
+
+    private:
+
+        using slot_t = ISharedSlot<args_t...>;
+
+        static constexpr std::uintptr_t kRemoved = 1;
+
+        static slot_t* toSlot(std::uintptr_t inLink) {
+            return reinterpret_cast<slot_t*>(inLink & ~kRemoved);
+        }
+
+        bool disconnect(slot_t& inSlot);
+
+        // unlinks the slots marked as removed, returns false if interrupted
+        bool unlinkRemoved();
+
+        unsigned beginRead();
+        void endRead(unsigned inParity);
+
+        // waits for the reads started before the call to complete
+        void synchronize();
+
+        std::atomic<std::uintptr_t> mSlots { 0 };
+        std::atomic<bool> mSyncLock { false };
+        std::atomic<unsigned> mEpoch { 0 };
+        std::atomic<unsigned> mReaders[2] = { 0u, 0u };
+
+        friend slot_t;
+    };
+
+
+    template<typename ... args_t>
+    void ISharedSlot<args_t...>::disconnect() {
+        if (auto* s = mSignal.load()) {
+            if (s->disconnect(*this)) {
+                this->disconnected();
+            }
+        }
+    }
+
+    template<typename ... args_t>
+    SharedSignal<args_t...>::~SharedSignal() {
+        // no emission can be in progress on a signal being destroyed
+        auto* s = toSlot(mSlots.load());
+        while (s) {
+            auto* next = toSlot(s->mNext.load());
+            s->mNext.store(0);
+            s->mSignal.store(nullptr);
+            s->disconnected();
+            s = next;
+        }
+    }
+
+    template<typename ... args_t>
+    bool SharedSignal<args_t...>::connect(slot_t& inSlot) {
+
+        SharedSignal* expected = nullptr;
+        if (!inSlot.mSignal.compare_exchange_strong(expected, this)) {
+            return false;
+        }
+
+        auto head = mSlots.load();
+        do {
+            inSlot.mNext.store(head);
+        } while (!mSlots.compare_exchange_weak(head, reinterpret_cast<std::uintptr_t>(&inSlot)));
+
+        inSlot.connected();
+        return true;
+    }
+
+    template<typename ... args_t>
+    void SharedSignal<args_t...>::emit(const args_t& ... args) {
+
+        const auto parity = beginRead();
+
+        auto* s = toSlot(mSlots.load());
+        while (s) {
+            s->processSignal(args...);
+            s = toSlot(s->mNext.load());
+        }
+
+        endRead(parity);
+    }
+
+    template<typename ... args_t>
+    bool SharedSignal<args_t...>::disconnect(slot_t& inSlot) {
+
+        // mark the slot as removed, the emissions still go through it
+        auto next = inSlot.mNext.load();
+        do {
+            if (next & kRemoved) {
+                // wait for a concurrent disconnection of this slot to complete
+                while (inSlot.mSignal.load() == this) {
+                    std::this_thread::yield();
+                }
+                return false;
+            }
+        } while (!inSlot.mNext.compare_exchange_weak(next, next | kRemoved));
+
+        // then unlink it, possibly along with other removed slots
+        while (!unlinkRemoved());
+
+        synchronize();
+
+        inSlot.mNext.store(0);
+        inSlot.mSignal.store(nullptr);
+        return true;
+    }
+
+    template<typename ... args_t>
+    bool SharedSignal<args_t...>::unlinkRemoved() {
+
+        // the walked slots can't be released during the read
+        const auto parity = beginRead();
+
+        std::atomic<std::uintptr_t>* link = &mSlots;
+        auto current = link->load();
+
+        while (current) {
+
+            auto* s = toSlot(current);
+            const auto next = s->mNext.load();
+
+            if (next & kRemoved) {
+                // fails if the link changed or if its owner is being removed
+                if (!link->compare_exchange_strong(current, next & ~kRemoved)) {
+                    endRead(parity);
+                    return false;
+                }
+                current = next & ~kRemoved;
+            }
+            else {
+                link = &s->mNext;
+                current = next;
+            }
+        }
+
+        endRead(parity);
+        return true;
+    }
+
+    template<typename ... args_t>
+    unsigned SharedSignal<args_t...>::beginRead() {
+        const unsigned parity = mEpoch.load() & 1u;
+        mReaders[parity].fetch_add(1);
+        return parity;
+    }
+
+    template<typename ... args_t>
+    void SharedSignal<args_t...>::endRead(unsigned inParity) {
+        mReaders[inParity].fetch_sub(1);
+    }
+
+    template<typename ... args_t>
+    void SharedSignal<args_t...>::synchronize() {
+        while (mSyncLock.exchange(true, std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        // flip twice so that a reader that sampled the epoch just before
+        // a flip is also waited for
+        for (int i = 0; i < 2; i++) {
+            const unsigned parity = mEpoch.fetch_add(1) & 1u;
+            while (mReaders[parity].load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+        mSyncLock.store(false, std::memory_order_release);
+    }
+
+}
@@ -27,35 +27,190 @@
 
 #pragma once
 
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
 #include "islot.hpp"
+#include "awaiter.hpp"
 
 namespace ustream {
 
+    /**
+     * @brief Instrumentation doing nothing.
+     *
+     * An instrumentation type provides :
+     * - void onEmit() : called once per emission
+     * - token_t beginSlot() : called before each slot call
+     * - void endSlot(token_t) : called after each slot call with the
+     *   value returned by beginSlot
+     */
+    struct NoInstrumentation {
+        void onEmit() {}
+        int beginSlot() { return 0; }
+        void endSlot(int) {}
+    };
+
+    /**
+     * @brief Order in which the slots of a priority level are called.
+     */
+    enum class eOrder {
+        LIFO,   ///< last connected slot called first
+        FIFO    ///< first connected slot called first
+    };
+
+    /**
+     * @brief Default signal policy.
+     *
+     * Policies customizing a signal derive from this one and override
+     * some of its members.
+     */
+    struct DefaultSignalPolicy {
+        /**
+         * @brief Instrumentation of the signal.
+         */
+        using instrumentation_t = NoInstrumentation;
+
+        /**
+         * @brief Number of priority levels of the signal.
+         */
+        static constexpr std::size_t priorityLevels = 1;
+
+        /**
+         * @brief Order of the slots within a priority level.
+         */
+        static constexpr eOrder order = eOrder::LIFO;
+    };
+
+    /**
+     * @brief Signal policy adding priority levels.
+     *
+     * @tparam levels Number of priority levels.
+     * @tparam base_policy_t Policy to extend.
+     */
+    template<std::size_t levels, typename base_policy_t = DefaultSignalPolicy>
+    struct PrioritySignalPolicy : base_policy_t {
+        static constexpr std::size_t priorityLevels = levels;
+    };
+
+    /**
+     * @brief Signal policy setting the order of the slots.
+     *
+     * @tparam slotOrder Order of the slots within a priority level.
+     * @tparam base_policy_t Policy to extend.
+     */
+    template<eOrder slotOrder, typename base_policy_t = DefaultSignalPolicy>
+    struct OrderSignalPolicy : base_policy_t {
+        static constexpr eOrder order = slotOrder;
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Slots of a signal, sorted by priority level and in the
+         * order set by the policy within a level.
+         *
+         * @tparam policy_t Signal policy, see DefaultSignalPolicy.
+         * @tparam slot_t Slot type, linked in the lists.
+         */
+        template<typename policy_t, typename slot_t>
+        struct SlotLists {
+
+            static constexpr std::size_t levels = policy_t::priorityLevels;
+
+            static_assert(levels != 0, "level count must not be zero");
+
+            bool connect(slot_t& inSlot, std::size_t inPriority);
+
+            // calls f with each slot in emission order, stops if f returns
+            // false, returns false if stopped
+            template<typename func_t>
+            bool forEach(func_t&& f);
+
+            bool isConnected() const;
+
+            ulink::List<slot_t> mLists[levels];
+        };
+
+    }
+
     /**
      * @brief Signal.
      *
+     * @tparam policy_t Signal policy, see DefaultSignalPolicy.
      * @tparam args_t Argument types of the signal.
      */
-    template<typename ... args_t>
-    struct Signal {
+    template<typename policy_t, typename ... args_t>
+    struct BasicSignal : private policy_t::instrumentation_t {
+
+        using instrumentation_t = typename policy_t::instrumentation_t;
+
+        static constexpr std::size_t priorityLevels = policy_t::priorityLevels;
 
         /**
          * @brief Connects a slot to this signal.
          *
+         * The slots are called by priority level, level 0 first, and in
+         * the order set by the policy within a level.
+         *
          * @param inSlot Slot to connect.
+         * @param inPriority Priority level, 0 being the highest priority.
          * @return true if the connection succeeded
          * @return false otherwise.
          */
-        bool connect(ISlot<args_t...>& inSlot);
+        bool connect(ISlot<args_t...>& inSlot, std::size_t inPriority = 0);
 
         /**
          * @brief Emits data to the connected slots.
          *
+         * The data is passed by reference down to the slots, so slots of a
+         * Signal<const T&> receive it without any copy.
+         *
          * @param args data to emit.
-         * @return true if at least one slot is connected
-         * @return false otherwise.
          */
-        void emit(args_t... args);
+        void emit(const args_t&... args);
+
+        /**
+         * @brief Emits a batch of data to the connected slots.
+         *
+         * Each slot receives the whole batch through processBatch before
+         * the next slot is called. The batch counts as one emission for the
+         * instrumentation.
+         *
+         * @param batch data to emit.
+         */
+        void emitBatch(Batch<args_t...> batch);
+
+        /**
+         * @brief Emits data built on demand to the connected slots.
+         *
+         * The factory is only called if a slot is connected, and only once.
+         * With several arguments, the factory returns them in a tuple.
+         *
+         * @param inFactory Function returning the data to emit.
+         */
+        template<typename factory_t>
+        void emitLazy(factory_t&& inFactory);
+
+        /**
+         * @brief Returns an awaitable resuming a coroutine on the next emission.
+         *
+         * The result of co_await is a copy of the data, in a tuple when
+         * the signal has several arguments. The awaiter is connected in
+         * front of the other slots whatever the order policy, so a coroutine
+         * awaiting again when resumed waits for the next emission.
+         *
+         * @return Awaitable.
+         */
+        auto next();
+
+        /**
+         * @brief Calls a function for each connected slot, in emission order.
+         *
+         * @param f Function called with each slot.
+         */
+        template<typename func_t>
+        void forEachSlot(func_t&& f);
 
         /**
          * @brief Tells if this signal is connected to at least one slot.
@@ -65,37 +220,179 @@ namespace ustream {
          */
         bool isConnected() const;
 
+        /**
+         * @brief Returns the instrumentation of this signal.
+         *
+         * @return Instrumentation.
+         */
+        const instrumentation_t& instrumentation() const { return *this; }
+
+        /**
+         * @brief Returns the instrumentation of this signal.
+         *
+         * @return Instrumentation.
+         */
+        instrumentation_t& instrumentation() { return *this; }
+
     protected:
-        ulink::List<ISlot<args_t...>> mSlots;
+        detail::SlotLists<policy_t, ISlot<args_t...>> mSlots;
     };
 
+    /**
+     * @brief Signal with the default policy.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
+    template<typename ... args_t>
+    using Signal = BasicSignal<DefaultSignalPolicy, args_t...>;
 
+    /**
+     * @brief Signal with priority levels.
+     *
+     * @tparam levels Number of priority levels.
+     * @tparam args_t Argument types of the signal.
+     */
+    template<std::size_t levels, typename ... args_t>
+    using PrioritySignal = BasicSignal<PrioritySignalPolicy<levels>, args_t...>;
+
+    /**
+     * @brief Signal calling its slots in connection order.
+     *
+     * @tparam args_t Argument types of the signal.
+     */
     template<typename ... args_t>
-    bool Signal<args_t...>::connect(ISlot<args_t...>& inSlot) {
-        if (inSlot.isLinked()) {
+    using FifoSignal = BasicSignal<OrderSignalPolicy<eOrder::FIFO>, args_t...>;
+
+
+    template<typename policy_t, typename slot_t>
+    bool detail::SlotLists<policy_t, slot_t>::connect(slot_t& inSlot, std::size_t inPriority) {
+        if (inSlot.isLinked() || inPriority >= levels) {
             return false;
         }
-        mSlots.push_front(inSlot);
+        if constexpr (policy_t::order == eOrder::FIFO) {
+            mLists[inPriority].push_back(inSlot);
+        }
+        else {
+            mLists[inPriority].push_front(inSlot);
+        }
         inSlot.connected();
         return true;
     }
 
-    template<typename ... args_t>
-    void Signal<args_t...>::emit(args_t ... args) {
+    template<typename policy_t, typename slot_t>
+    template<typename func_t>
+    bool detail::SlotLists<policy_t, slot_t>::forEach(func_t&& f) {
+        for (auto& slots : mLists) {
 
-        auto it = mSlots.begin();
-        const auto end = mSlots.end();
+            auto it = slots.begin();
+            const auto end = slots.end();
 
-        while (it != end) {
-            auto& s = *it;
-            ++it;
-            s.processSignal(args...);
+            while (it != end) {
+                auto& s = *it;
+                // the slot may disconnect itself
+                ++it;
+                if constexpr (std::is_void_v<decltype(f(s))>) {
+                    f(s);
+                }
+                else if (!f(s)) {
+                    return false;
+                }
+            }
         }
+        return true;
     }
 
-    template<typename ... args_t>
-    bool Signal<args_t...>::isConnected() const {
-        return !mSlots.empty();
+    template<typename policy_t, typename slot_t>
+    bool detail::SlotLists<policy_t, slot_t>::isConnected() const {
+        for (const auto& slots : mLists) {
+            if (!slots.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename policy_t, typename ... args_t>
+    bool BasicSignal<policy_t, args_t...>::connect(ISlot<args_t...>& inSlot, std::size_t inPriority) {
+        return mSlots.connect(inSlot, inPriority);
+    }
+
+    template<typename policy_t, typename ... args_t>
+    void BasicSignal<policy_t, args_t...>::emit(const args_t& ... args) {
+
+        this->onEmit();
+
+        mSlots.forEach(
+            [&](ISlot<args_t...>& s) {
+                const auto token = this->beginSlot();
+                s.processSignal(args...);
+                this->endSlot(token);
+            }
+        );
+    }
+
+    template<typename policy_t, typename ... args_t>
+    void BasicSignal<policy_t, args_t...>::emitBatch(Batch<args_t...> batch) {
+
+        this->onEmit();
+
+        mSlots.forEach(
+            [&](ISlot<args_t...>& s) {
+                const auto token = this->beginSlot();
+                s.processBatch(batch);
+                this->endSlot(token);
+            }
+        );
+    }
+
+    template<typename policy_t, typename ... args_t>
+    template<typename factory_t>
+    void BasicSignal<policy_t, args_t...>::emitLazy(factory_t&& inFactory) {
+
+        if (!isConnected()) {
+            return;
+        }
+
+        if constexpr (sizeof...(args_t) == 1) {
+            emit(inFactory());
+        }
+        else {
+            std::apply(
+                [this](const auto&... args) {
+                    emit(args...);
+                },
+                inFactory()
+            );
+        }
+    }
+
+    template<typename policy_t, typename ... args_t>
+    auto BasicSignal<policy_t, args_t...>::next() {
+        auto connector = [this](ISlot<args_t...>& inSlot) {
+            // the running emission has passed the front of the lists
+            if (inSlot.isLinked()) {
+                return false;
+            }
+            mSlots.mLists[0].push_front(inSlot);
+            inSlot.connected();
+            return true;
+        };
+        return Awaiter<decltype(connector), args_t...>(connector);
+    }
+
+    template<typename policy_t, typename ... args_t>
+    template<typename func_t>
+    void BasicSignal<policy_t, args_t...>::forEachSlot(func_t&& f) {
+        mSlots.forEach(
+            [&](ISlot<args_t...>& s) {
+                f(s);
+            }
+        );
+    }
+
+    template<typename policy_t, typename ... args_t>
+    bool BasicSignal<policy_t, args_t...>::isConnected() const {
+        return mSlots.isConnected();
     }
 
 }
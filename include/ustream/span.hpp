@@ -0,0 +1,103 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace ustream {
+
+    /**
+     * @brief Non-owning view over contiguous elements.
+     *
+     * @tparam T Element type.
+     */
+    template<typename T>
+    struct Span {
+
+        constexpr Span() = default;
+
+        /**
+         * @brief Constructs a span from a pointer and a size.
+         *
+         * @param inData First element.
+         * @param inSize Number of elements.
+         */
+        constexpr Span(T* inData, std::size_t inSize) : mData(inData), mSize(inSize) {}
+
+        /**
+         * @brief Constructs a span viewing an array.
+         *
+         * @param inArray Array to view.
+         */
+        template<
+            typename U,
+            std::size_t N,
+            typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>
+        >
+        constexpr Span(U(&inArray)[N]) : mData(inArray), mSize(N) {}
+
+        /**
+         * @brief Constructs a span viewing a contiguous container.
+         *
+         * @param inContainer Container providing data() and size().
+         */
+        template<
+            typename container_t,
+            typename = std::enable_if_t<
+                std::is_convertible_v<decltype(std::declval<container_t&>().data()), T*>
+            >
+        >
+        constexpr Span(container_t& inContainer) : mData(inContainer.data()), mSize(inContainer.size()) {}
+
+        /**
+         * @brief Constructs a const span from a mutable one.
+         *
+         * @param inSpan Span to view.
+         */
+        template<
+            typename U,
+            typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>
+        >
+        constexpr Span(const Span<U>& inSpan) : mData(inSpan.data()), mSize(inSpan.size()) {}
+
+        constexpr T* data() const { return mData; }
+        constexpr std::size_t size() const { return mSize; }
+        constexpr bool empty() const { return mSize == 0; }
+
+        constexpr T* begin() const { return mData; }
+        constexpr T* end() const { return mData + mSize; }
+
+        constexpr T& operator[](std::size_t inIndex) const { return mData[inIndex]; }
+
+    private:
+        T* mData = nullptr;
+        std::size_t mSize = 0;
+    };
+
+}
@@ -0,0 +1,147 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#ifndef USTREAM_CACHE_LINE_SIZE
+/**
+ * @brief Alignment used to keep the data written by different threads apart.
+ */
+#define USTREAM_CACHE_LINE_SIZE 64
+#endif
+
+namespace ustream {
+
+    /**
+     * @brief Lock-free single producer single consumer ring buffer.
+     *
+     * The elements are stored in the ring itself, no heap allocation is made.
+     *
+     * @tparam T Element type.
+     * @tparam N Capacity, must be a power of two.
+     */
+    template<typename T, std::size_t N>
+    struct SPSCRing {
+
+        // the indexes wrap around
+        static_assert(N != 0 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+        SPSCRing() = default;
+        SPSCRing(const SPSCRing&) = delete;
+
+        ~SPSCRing() {
+            while (pop([](T&) {}));
+        }
+
+        /**
+         * @brief Constructs an element at the end of the ring.
+         *
+         * Must only be called by the producer.
+         *
+         * @param args Element constructor arguments.
+         * @return true if the element was pushed
+         * @return false if the ring is full.
+         */
+        template<typename ... ctor_args_t>
+        bool push(ctor_args_t&&... args);
+
+        /**
+         * @brief Passes the first element of the ring to a function and removes it.
+         *
+         * Must only be called by the consumer.
+         *
+         * @param f Function called with a reference to the element.
+         * @return true if an element was popped
+         * @return false if the ring is empty.
+         */
+        template<typename func_t>
+        bool pop(func_t&& f);
+
+        /**
+         * @brief Tells if the ring is empty.
+         *
+         * @return true if the ring is empty
+         * @return false otherwise.
+         */
+        bool empty() const {
+            return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Returns the capacity of the ring.
+         *
+         * @return Capacity.
+         */
+        static constexpr std::size_t capacity() { return N; }
+
+    private:
+
+        T* at(std::size_t inIndex) {
+            return std::launder(reinterpret_cast<T*>(mBuffer[inIndex % N]));
+        }
+
+        // written by the consumer
+        alignas(USTREAM_CACHE_LINE_SIZE) std::atomic<std::size_t> mHead { 0 };
+        // written by the producer
+        alignas(USTREAM_CACHE_LINE_SIZE) std::atomic<std::size_t> mTail { 0 };
+
+        alignas(USTREAM_CACHE_LINE_SIZE) alignas(T) unsigned char mBuffer[N][sizeof(T)];
+    };
+
+
+    template<typename T, std::size_t N>
+    template<typename ... ctor_args_t>
+    bool SPSCRing<T, N>::push(ctor_args_t&&... args) {
+        const auto tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        new (mBuffer[tail % N]) T(std::forward<ctor_args_t>(args)...);
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T, std::size_t N>
+    template<typename func_t>
+    bool SPSCRing<T, N>::pop(func_t&& f) {
+        const auto head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        T* element = at(head);
+        f(*element);
+        element->~T();
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+}
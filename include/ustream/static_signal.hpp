@@ -0,0 +1,88 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace ustream {
+
+    /**
+     * @brief Signal whose slots are known at compile time.
+     *
+     * The slots are held by reference with their concrete type, so emit
+     * is a sequence of direct calls that the compiler can inline. Slots don't
+     * have to derive from ISlot : any type providing a processSignal method
+     * accepting the emitted arguments is valid. If a slot derives from ISlot,
+     * declare it (or its processSignal) final to allow devirtualization.
+     *
+     * @tparam slots_t Slot types, called in declaration order.
+     */
+    template<typename ... slots_t>
+    struct StaticSignal {
+
+        /**
+         * @brief Constructs the signal with its slots.
+         *
+         * @param inSlots Slots to connect.
+         */
+        constexpr StaticSignal(slots_t&... inSlots) : mSlots(inSlots...) {}
+
+        /**
+         * @brief Emits data to the slots.
+         *
+         * @param args data to emit.
+         */
+        template<typename ... args_t>
+        void emit(args_t&&... args) const;
+
+        /**
+         * @brief Returns the number of slots of this signal.
+         *
+         * @return Number of slots.
+         */
+        static constexpr std::size_t size() { return sizeof...(slots_t); }
+
+    private:
+
+        template<std::size_t ... indexes, typename ... args_t>
+        void emitImpl(std::index_sequence<indexes...>, args_t&... args) const {
+            (std::get<indexes>(mSlots).processSignal(args...), ...);
+        }
+
+        std::tuple<slots_t&...> mSlots;
+    };
+
+    template<typename ... slots_t>
+    template<typename ... args_t>
+    void StaticSignal<slots_t...>::emit(args_t&&... args) const {
+        emitImpl(std::index_sequence_for<slots_t...>{}, args...);
+    }
+
+}
@@ -0,0 +1,184 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#include "executor.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Executor running its tasks one at a time on another executor.
+     *
+     * The tasks are pushed into a lock-free queue and run in posting order
+     * by a single task of the underlying executor, posted when the strand
+     * has work, so many strands can share the threads of a pool. The tasks
+     * of a strand never run concurrently.
+     *
+     * The strand must outlive the tasks posted to it, see idle().
+     */
+    struct Strand final : IExecutor {
+
+        /**
+         * @brief Constructs a strand.
+         *
+         * @param inExecutor Executor running the tasks of the strand.
+         */
+        explicit Strand(IExecutor& inExecutor);
+
+        Strand(const Strand&) = delete;
+
+        void post(Task& inTask) override;
+
+        std::size_t concurrency() const override { return 1; }
+
+        bool isCurrent() const override { return current() == this; }
+
+        /**
+         * @brief Tells if no task of this strand is queued or running.
+         *
+         * @return true if the strand is idle
+         * @return false otherwise.
+         */
+        bool idle() const { return mPending.load() == 0; }
+
+    private:
+
+        struct Runner final : Task {
+            void run() override {
+                mStrand->runTasks();
+            }
+            Strand* mStrand = nullptr;
+        };
+
+        struct Stub final : Task {
+            void run() override {}
+        };
+
+        // strand running on the calling thread
+        static const Strand*& current() {
+            thread_local const Strand* sCurrent = nullptr;
+            return sCurrent;
+        }
+
+        void push(Task& inTask);
+
+        Task* pop();
+
+        void runTasks();
+
+        IExecutor& mExecutor;
+        Runner mRunner;
+        Stub mStub;
+        // number of posted tasks not completed yet
+        std::atomic<std::size_t> mPending { 0 };
+        // written by the producers
+        std::atomic<Task*> mTail;
+        // read by the runner
+        Task* mHead;
+    };
+
+
+    inline Strand::Strand(IExecutor& inExecutor) :
+        mExecutor(inExecutor),
+        mTail(&mStub),
+        mHead(&mStub) {
+        mRunner.mStrand = this;
+    }
+
+    inline void Strand::post(Task& inTask) {
+        push(inTask);
+        if (mPending.fetch_add(1) == 0) {
+            mExecutor.post(mRunner);
+        }
+    }
+
+    inline void Strand::push(Task& inTask) {
+        inTask.mNext.store(nullptr, std::memory_order_relaxed);
+        Task* previous = mTail.exchange(&inTask, std::memory_order_acq_rel);
+        previous->mNext.store(&inTask, std::memory_order_release);
+    }
+
+    inline Task* Strand::pop() {
+
+        Task* head = mHead;
+        Task* next = head->mNext.load(std::memory_order_acquire);
+
+        if (head == &mStub) {
+            if (!next) {
+                return nullptr;
+            }
+            mHead = next;
+            head = next;
+            next = next->mNext.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            mHead = next;
+            return head;
+        }
+
+        if (head != mTail.load(std::memory_order_acquire)) {
+            // a producer is linking a task
+            return nullptr;
+        }
+
+        // the last task can only be removed with the stub behind it
+        push(mStub);
+
+        next = head->mNext.load(std::memory_order_acquire);
+
+        if (next) {
+            mHead = next;
+            return head;
+        }
+
+        return nullptr;
+    }
+
+    inline void Strand::runTasks() {
+
+        const Strand* previous = current();
+        current() = this;
+
+        do {
+            Task* task;
+            // the task was counted before being fully linked
+            while (!(task = pop())) {
+                std::this_thread::yield();
+            }
+            task->run();
+        } while (mPending.fetch_sub(1) != 1);
+
+        current() = previous;
+    }
+
+}
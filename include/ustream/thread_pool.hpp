@@ -0,0 +1,135 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ustream                                   *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "executor.hpp"
+
+namespace ustream {
+
+    /**
+     * @brief Executor running tasks on a fixed set of threads.
+     *
+     * The threads are started on construction and take the tasks from a
+     * shared queue. The destructor runs the queued tasks and joins the
+     * threads.
+     *
+     * @tparam threads Number of threads.
+     */
+    template<std::size_t threads>
+    struct ThreadPool final : IExecutor {
+
+        static_assert(threads != 0, "thread count must not be zero");
+
+        ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+
+        ~ThreadPool();
+
+        void post(Task& inTask) override;
+
+        std::size_t concurrency() const override { return threads; }
+
+        bool isCurrent() const override { return current() == this; }
+
+    private:
+
+        // pool running on the calling thread
+        static const ThreadPool*& current() {
+            thread_local const ThreadPool* sCurrent = nullptr;
+            return sCurrent;
+        }
+
+        void work();
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        detail::TaskQueue mTasks;
+        bool mStop = false;
+        std::thread mThreads[threads];
+    };
+
+
+    template<std::size_t threads>
+    ThreadPool<threads>::ThreadPool() {
+        for (auto& t : mThreads) {
+            t = std::thread([this] { work(); });
+        }
+    }
+
+    template<std::size_t threads>
+    ThreadPool<threads>::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+        for (auto& t : mThreads) {
+            t.join();
+        }
+    }
+
+    template<std::size_t threads>
+    void ThreadPool<threads>::post(Task& inTask) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTasks.push(inTask);
+        }
+        mCondition.notify_one();
+    }
+
+    template<std::size_t threads>
+    void ThreadPool<threads>::work() {
+
+        current() = this;
+
+        while (true) {
+
+            Task* task;
+
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this] { return !mTasks.empty() || mStop; });
+
+                task = mTasks.pop();
+
+                if (!task) {
+                    return;
+                }
+            }
+
+            task->run();
+        }
+    }
+
+}
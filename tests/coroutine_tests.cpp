@@ -0,0 +1,160 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ustream/signal.hpp"
+#include "ustream/broadcast.hpp"
+
+namespace {
+
+    // coroutine started immediately and destroyed when it completes
+    struct Detached {
+        struct promise_type {
+            Detached get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    // waits for a start byte, a length, then the payload bytes
+    Detached receiveFrames(ustream::Signal<unsigned char>& inBytes, std::vector<std::string>& outFrames, std::size_t inCount) {
+        while (outFrames.size() != inCount) {
+            while (co_await inBytes.next() != 0x7E);
+            const auto length = co_await inBytes.next();
+            std::string frame;
+            for (unsigned char i = 0; i < length; i++) {
+                frame += static_cast<char>(co_await inBytes.next());
+            }
+            outFrames.push_back(frame);
+        }
+    }
+
+    Detached sumPairs(ustream::Signal<int, const std::string&>& inSignal, int& outSum, std::string& outText, int inCount) {
+        for (int i = 0; i < inCount; i++) {
+            auto [n, s] = co_await inSignal.next();
+            outSum += n;
+            outText += s;
+        }
+    }
+
+    Detached waitTicks(ustream::Signal<>& inTicks, int& outTicks) {
+        co_await inTicks.next();
+        outTicks++;
+        co_await inTicks.next();
+        outTicks++;
+    }
+
+    Detached collect(ustream::FifoSignal<int>& inSignal, std::vector<int>& outValues, std::size_t inCount) {
+        while (outValues.size() != inCount) {
+            outValues.push_back(co_await inSignal.next());
+        }
+    }
+
+    Detached receivePort(int& outValue) {
+        outValue = co_await ustream::receive<52, int>();
+        outValue += co_await ustream::receive<52, int>();
+    }
+
+}
+
+TEST_CASE("signal coroutine tests") {
+
+    ustream::Signal<unsigned char> bytes;
+    std::vector<std::string> frames;
+
+    receiveFrames(bytes, frames, 2);
+
+    CHECK(bytes.isConnected());
+
+    const unsigned char input[] = { 0x01, 0x7E, 0x02, 'o', 'k', 0x55, 0x7E, 0x03, 'a', 'b', 'c' };
+
+    for (unsigned char b : input) {
+        bytes.emit(b);
+    }
+
+    CHECK(frames == std::vector<std::string>{ "ok", "abc" });
+
+    // the coroutine completed
+    CHECK(!bytes.isConnected());
+
+    int sum = 0;
+    std::string text;
+    ustream::Signal<int, const std::string&> pairs;
+
+    sumPairs(pairs, sum, text, 2);
+
+    pairs.emit(1, "a");
+    pairs.emit(2, "b");
+
+    CHECK(sum == 3);
+    CHECK(text == "ab");
+
+    // the coroutine completed
+    CHECK(!pairs.isConnected());
+
+    int ticks = 0;
+    ustream::Signal<> tickSignal;
+
+    waitTicks(tickSignal, ticks);
+
+    tickSignal.emit();
+    CHECK(ticks == 1);
+    tickSignal.emit();
+    tickSignal.emit();
+    CHECK(ticks == 2);
+    CHECK(!tickSignal.isConnected());
+}
+
+TEST_CASE("broadcast coroutine tests") {
+
+    int value = 0;
+
+    receivePort(value);
+
+    ustream::broadcast<52>(3);
+    CHECK(value == 3);
+
+    ustream::broadcast<52>(4);
+    CHECK(value == 7);
+
+    ustream::broadcast<52>(5);
+    CHECK(value == 7);
+}
+
+TEST_CASE("fifo signal coroutine tests") {
+
+    struct Slot : ustream::ISlot<int> {
+        void processSignal(int i) override {
+            mValues.push_back(i);
+        }
+        std::vector<int> mValues;
+    };
+
+    ustream::FifoSignal<int> sig;
+    Slot slot;
+    std::vector<int> values;
+
+    // the awaiter is followed by a slot
+    collect(sig, values, 3);
+    sig.connect(slot);
+
+    // the coroutine awaiting again is not resumed twice by the same emission
+    sig.emit(1);
+    sig.emit(2);
+
+    CHECK(values == std::vector<int>{ 1, 2 });
+    CHECK(slot.mValues == std::vector<int>{ 1, 2 });
+
+    sig.emit(3);
+
+    CHECK(values == std::vector<int>{ 1, 2, 3 });
+    CHECK(slot.isConnected());
+}
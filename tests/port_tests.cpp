@@ -0,0 +1,46 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <string>
+
+// instrumented broadcast ports, for this test executable only
+#include "ustream/instrumentation.hpp"
+#define USTREAM_PORT_POLICY ustream::InstrumentedSignalPolicy
+
+#include "ustream/signal.hpp"
+#include "ustream/broadcast.hpp"
+
+TEST_CASE("instrumented port tests") {
+
+    struct Slot : ustream::ISlot<int> {
+        void processSignal(int i) override {
+            mSum += i;
+        }
+        int mSum = 0;
+    };
+
+    Slot slot;
+    ustream::open<48>(slot);
+
+    ustream::broadcast<48>(1);
+    ustream::broadcast<48>(2);
+
+    CHECK(slot.mSum == 3);
+
+    bool found = false;
+
+    ustream::forEachPort(
+        [&](const char* name, const ustream::Instrumentation<>& portStats) {
+            const std::string n(name);
+            if (n.find("48") != std::string::npos && portStats.slotCallCount() != 0) {
+                found = true;
+                CHECK(portStats.emitCount() == 2);
+                CHECK(portStats.slotCallCount() == 2);
+            }
+        }
+    );
+
+    CHECK(found);
+
+    ustream::close(slot);
+}
@@ -1,11 +1,36 @@
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
+#include "ustream/instrumentation.hpp"
 #include "ustream/islot.hpp"
 #include "ustream/signal.hpp"
 #include "ustream/broadcast.hpp"
+#include "ustream/static_signal.hpp"
+#include "ustream/flat_signal.hpp"
+#include "ustream/global_broadcast.hpp"
+#include "ustream/queued_slot.hpp"
+#include "ustream/mailbox_slot.hpp"
+#include "ustream/delegate.hpp"
+#include "ustream/keyed_signal.hpp"
+#include "ustream/consumable_signal.hpp"
+#include "ustream/connections.hpp"
+#include "ustream/result_signal.hpp"
+#include "ustream/chained_signal.hpp"
+#include "ustream/thread_pool.hpp"
+#include "ustream/fan_out.hpp"
+#include "ustream/event_loop.hpp"
+#include "ustream/routed_slot.hpp"
+#include "ustream/strand.hpp"
+#include "ustream/multicast_ring.hpp"
 
 TEST_CASE("basic uStream tests") {
 
@@ -116,3 +141,2116 @@ TEST_CASE("basic uStream tests") {
 
 }
 
+
+TEST_CASE("static signal tests") {
+
+    struct Slot final : ustream::ISlot<int> {
+        void processSignal(int i) override {
+            mRXData = i;
+        }
+        int mRXData = 0;
+    };
+
+    struct Accumulator {
+        void processSignal(int i) {
+            mSum += i;
+        }
+        int mSum = 0;
+    };
+
+    Slot slot;
+    Accumulator acc;
+
+    ustream::StaticSignal sig(slot, acc);
+
+    static_assert(decltype(sig)::size() == 2);
+
+    sig.emit(12);
+
+    CHECK(slot.mRXData == 12);
+    CHECK(acc.mSum == 12);
+
+    sig.emit(30);
+
+    CHECK(slot.mRXData == 30);
+    CHECK(acc.mSum == 42);
+
+    struct Incrementer {
+        void processSignal(int& i) {
+            i++;
+        }
+    };
+
+    Incrementer inc1;
+    Incrementer inc2;
+
+    ustream::StaticSignal refSig(inc1, inc2);
+
+    int i = 0;
+    refSig.emit(i);
+
+    CHECK(i == 2);
+}
+
+TEST_CASE("flat signal tests") {
+
+    ustream::FlatSignal<3, int> sig;
+
+    struct Slot : ustream::IFlatSlot<int> {
+
+        void connected() override {
+            connectState = true;
+        }
+
+        void disconnected() override {
+            connectState = false;
+        }
+
+        void processSignal(int i) override {
+            mRXData = i;
+        }
+
+        int mRXData = 0;
+        bool connectState = false;
+    };
+
+    Slot slot1;
+    Slot slot2;
+    Slot slot3;
+    Slot slot4;
+
+    CHECK(!sig.isConnected());
+
+    CHECK(sig.connect(slot1));
+    CHECK(slot1.connectState);
+    CHECK(slot1.isConnected());
+
+    // already connected
+    CHECK(!sig.connect(slot1));
+
+    CHECK(sig.connect(slot2));
+    CHECK(sig.connect(slot3));
+
+    // full
+    CHECK(!sig.connect(slot4));
+    CHECK(sig.size() == 3);
+
+    sig.emit(42);
+
+    CHECK(slot1.mRXData == 42);
+    CHECK(slot2.mRXData == 42);
+    CHECK(slot3.mRXData == 42);
+    CHECK(slot4.mRXData == 0);
+
+    CHECK(sig.disconnect(slot1));
+    CHECK(!slot1.connectState);
+    CHECK(!slot1.isConnected());
+    CHECK(!sig.disconnect(slot1));
+    CHECK(sig.size() == 2);
+
+    sig.emit(12);
+
+    CHECK(slot1.mRXData == 42);
+    CHECK(slot2.mRXData == 12);
+    CHECK(slot3.mRXData == 12);
+
+    // a slot connected to another signal can't be connected
+    {
+        ustream::FlatSignal<1, int> otherSig;
+        CHECK(otherSig.connect(slot4));
+        CHECK(!sig.connect(slot4));
+        CHECK(!sig.disconnect(slot4));
+    }
+
+    // the destroyed signal left its slot disconnected
+    CHECK(!slot4.isConnected());
+    CHECK(sig.connect(slot4));
+
+    // the slot disconnects itself, the moved slot keeps being reachable
+    slot2.disconnect();
+    CHECK(!slot2.connectState);
+    CHECK(sig.size() == 2);
+    CHECK(sig.disconnect(slot4));
+    CHECK(sig.size() == 1);
+    CHECK(sig.connect(slot4));
+
+    struct SelfRemovingSlot : ustream::IFlatSlot<int> {
+        void processSignal(int i) override {
+            mRXData = i;
+            disconnect();
+        }
+        int mRXData = 0;
+    };
+
+    {
+        SelfRemovingSlot selfRemoving;
+        CHECK(sig.connect(selfRemoving));
+
+        sig.emit(7);
+
+        CHECK(selfRemoving.mRXData == 7);
+        CHECK(slot3.mRXData == 7);
+        CHECK(slot4.mRXData == 7);
+        CHECK(sig.size() == 2);
+
+        sig.emit(8);
+
+        CHECK(selfRemoving.mRXData == 7);
+        CHECK(slot3.mRXData == 8);
+        CHECK(slot4.mRXData == 8);
+
+        // a deleted slot removes itself from the signal
+        Slot temporary;
+        CHECK(sig.connect(temporary));
+        CHECK(sig.size() == 3);
+    }
+
+    CHECK(sig.size() == 2);
+    sig.emit(9);
+    CHECK(slot3.mRXData == 9);
+    CHECK(slot4.mRXData == 9);
+
+    // a slot disconnecting another one not called yet
+    struct CountingSlot : ustream::IFlatSlot<int> {
+        void processSignal(int) override {
+            mCount++;
+            if (mOther) {
+                mOther->disconnect();
+            }
+        }
+        ustream::IFlatSlot<int>* mOther = nullptr;
+        int mCount = 0;
+    };
+
+    ustream::FlatSignal<4, int> sig2;
+    CountingSlot a;
+    CountingSlot b;
+    CountingSlot c;
+    CountingSlot d;
+
+    sig2.connect(a);
+    sig2.connect(b);
+    sig2.connect(c);
+    sig2.connect(d);
+
+    // called first, disconnects b
+    d.mOther = &b;
+    sig2.emit(0);
+
+    CHECK(a.mCount == 1);
+    CHECK(b.mCount == 0);
+    CHECK(c.mCount == 1);
+    CHECK(d.mCount == 1);
+    CHECK(sig2.size() == 3);
+
+    // disconnects a slot already called
+    d.mOther = nullptr;
+    a.mOther = &d;
+    sig2.emit(0);
+
+    CHECK(a.mCount == 2);
+    CHECK(c.mCount == 2);
+    CHECK(d.mCount == 2);
+    CHECK(sig2.size() == 2);
+
+    a.mOther = nullptr;
+    sig2.emit(0);
+
+    CHECK(a.mCount == 3);
+    CHECK(c.mCount == 3);
+}
+
+namespace {
+
+    struct Payload {
+        Payload() = default;
+        Payload(const Payload& other) : mValue(other.mValue) {
+            sCopies++;
+        }
+        Payload& operator=(const Payload& other) {
+            mValue = other.mValue;
+            sCopies++;
+            return *this;
+        }
+        int mValue = 0;
+        char mData[200] = {};
+        static inline int sCopies = 0;
+    };
+
+}
+
+TEST_CASE("zero copy tests") {
+
+    struct RefSlot : ustream::ISlot<const Payload&> {
+        void processSignal(const Payload& p) override {
+            mRXData = p.mValue;
+        }
+        int mRXData = 0;
+    };
+
+    struct ValueSlot : ustream::ISlot<Payload> {
+        void processSignal(Payload p) override {
+            mRXData = p.mValue;
+        }
+        int mRXData = 0;
+    };
+
+    RefSlot refSlot1;
+    RefSlot refSlot2;
+    ValueSlot valueSlot;
+
+    Payload payload;
+    payload.mValue = 42;
+
+    // connected mode
+    ustream::Signal<const Payload&> sig;
+    sig.connect(refSlot1);
+    sig.connect(refSlot2);
+
+    Payload::sCopies = 0;
+    sig.emit(payload);
+    CHECK(Payload::sCopies == 0);
+    CHECK(refSlot1.mRXData == 42);
+    CHECK(refSlot2.mRXData == 42);
+
+    refSlot1.disconnect();
+    refSlot2.disconnect();
+
+    // broadcast mode : by value and by reference slots share the same address
+    CHECK(ustream::open<45>(refSlot1));
+    CHECK(ustream::open<45>(refSlot2));
+
+    payload.mValue = 12;
+    Payload::sCopies = 0;
+    ustream::broadcast<45>(payload);
+    CHECK(Payload::sCopies == 0);
+    CHECK(refSlot1.mRXData == 12);
+    CHECK(refSlot2.mRXData == 12);
+
+    CHECK(ustream::open<45>(valueSlot));
+
+    payload.mValue = 13;
+    Payload::sCopies = 0;
+    ustream::broadcast<45>(payload);
+    // only the by value slot copies the payload
+    CHECK(Payload::sCopies == 1);
+    CHECK(refSlot1.mRXData == 13);
+    CHECK(refSlot2.mRXData == 13);
+    CHECK(valueSlot.mRXData == 13);
+
+    payload.mValue = 14;
+    Payload::sCopies = 0;
+    ustream::broadcast<45, const Payload&>(payload);
+    CHECK(Payload::sCopies == 1);
+    CHECK(refSlot1.mRXData == 14);
+    CHECK(valueSlot.mRXData == 14);
+
+    ustream::close(valueSlot);
+    ustream::close(refSlot1);
+    ustream::close(refSlot2);
+}
+
+TEST_CASE("global broadcast tests") {
+
+    struct Slot : ustream::ISharedSlot<int> {
+
+        ~Slot() {
+            disconnect();
+        }
+
+        void connected() override {
+            connectState = true;
+        }
+
+        void disconnected() override {
+            connectState = false;
+        }
+
+        void processSignal(int i) override {
+            mRXData = i;
+            mCount++;
+        }
+
+        std::atomic<int> mRXData { 0 };
+        std::atomic<int> mCount { 0 };
+        bool connectState = false;
+    };
+
+    Slot slot1;
+    Slot slot2;
+
+    CHECK(ustream::global::open<46>(slot1));
+    CHECK(slot1.connectState);
+    CHECK(slot1.isConnected());
+
+    // already opened
+    CHECK(!ustream::global::open<47>(slot1));
+
+    // a slot opened on this thread receives the data broadcast from another thread
+    std::thread([] { ustream::global::broadcast<46>(12); }).join();
+
+    CHECK(slot1.mRXData == 12);
+
+    // and the other way around
+    std::thread([&] { CHECK(ustream::global::open<46>(slot2)); }).join();
+
+    ustream::global::broadcast<46>(13);
+
+    CHECK(slot1.mRXData == 13);
+    CHECK(slot2.mRXData == 13);
+
+    ustream::global::close(slot1);
+    CHECK(!slot1.connectState);
+    CHECK(!slot1.isConnected());
+
+    ustream::global::broadcast<46>(14);
+
+    CHECK(slot1.mRXData == 13);
+    CHECK(slot2.mRXData == 14);
+
+    // concurrent broadcasts, opens and closes
+    constexpr int kBroadcasts = 20000;
+
+    std::atomic<bool> run { true };
+    std::vector<std::thread> producers;
+
+    for (int t = 0; t < 4; t++) {
+        producers.emplace_back([&] {
+            for (int i = 0; i < kBroadcasts; i++) {
+                ustream::global::broadcast<46>(i);
+            }
+        });
+    }
+
+    std::thread churn([&] {
+        while (run) {
+            Slot s;
+            ustream::global::open<46>(s);
+            ustream::global::close(s);
+        }
+    });
+
+    for (auto& p : producers) {
+        p.join();
+    }
+
+    run = false;
+    churn.join();
+
+    CHECK(slot2.mCount == 2 + 4 * kBroadcasts);
+
+    ustream::global::close(slot2);
+}
+
+TEST_CASE("queued slot tests") {
+
+    struct Slot : ustream::ISlot<int, const int&> {
+        void processSignal(int i, const int& j) override {
+            mRXData = i + j;
+            mCount++;
+        }
+        int mRXData = 0;
+        int mCount = 0;
+    };
+
+    Slot target;
+    ustream::QueuedSlot<4, int, const int&> queued(target);
+    ustream::Signal<int, const int&> sig;
+
+    CHECK(sig.connect(queued));
+
+    sig.emit(1, 2);
+    sig.emit(3, 4);
+
+    // nothing is processed until the consumer polls
+    CHECK(target.mCount == 0);
+
+    CHECK(queued.poll());
+    CHECK(target.mRXData == 3);
+
+    CHECK(queued.drain() == 1);
+    CHECK(target.mRXData == 7);
+
+    CHECK(!queued.poll());
+    CHECK(queued.drain() == 0);
+
+    for (int i = 0; i < 6; i++) {
+        sig.emit(i, 0);
+    }
+
+    CHECK(queued.dropped() == 2);
+    CHECK(queued.drain() == 4);
+    CHECK(target.mRXData == 3);
+    CHECK(target.mCount == 6);
+
+    // cross thread
+    constexpr int kCount = 100000;
+
+    struct Accumulator : ustream::ISlot<int> {
+        void processSignal(int i) override {
+            mOrdered &= (i == mNext);
+            mNext = i + 1;
+        }
+        int mNext = 0;
+        bool mOrdered = true;
+    };
+
+    Accumulator acc;
+    ustream::QueuedSlot<64, int> accQueue(acc);
+
+    std::thread producer([&] {
+        ustream::Signal<int> producerSig;
+        producerSig.connect(accQueue);
+        int i = 0;
+        while (i < kCount) {
+            const auto dropped = accQueue.dropped();
+            producerSig.emit(i);
+            if (accQueue.dropped() == dropped) {
+                i++;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+        accQueue.disconnect();
+    });
+
+    while (acc.mNext != kCount) {
+        if (accQueue.drain() == 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    CHECK(acc.mOrdered);
+}
+
+TEST_CASE("mailbox slot tests") {
+
+    struct Slot : ustream::ISlot<int, int> {
+        void processSignal(int producer, int i) override {
+            mOrdered &= (i == mNext[producer]);
+            mNext[producer] = i + 1;
+            mCount++;
+        }
+        int mNext[4] = {};
+        int mCount = 0;
+        bool mOrdered = true;
+    };
+
+    Slot target;
+    ustream::MailboxSlot<8, int, int> mailbox(target);
+    ustream::SharedSignal<int, int> sig;
+
+    CHECK(sig.connect(mailbox));
+
+    sig.emit(0, 0);
+    sig.emit(0, 1);
+    sig.emit(0, 2);
+
+    CHECK(target.mCount == 0);
+
+    CHECK(mailbox.drain(2) == 2);
+    CHECK(target.mCount == 2);
+    CHECK(mailbox.drain() == 1);
+    CHECK(mailbox.drain() == 0);
+
+    for (int i = 3; i < 13; i++) {
+        sig.emit(1, i - 3);
+    }
+
+    CHECK(mailbox.dropped() == 2);
+
+    // the producer knows its data was dropped
+    CHECK(!mailbox.push(2, 0));
+    CHECK(mailbox.dropped() == 3);
+
+    CHECK(mailbox.drain() == 8);
+    CHECK(mailbox.push(2, 0));
+    CHECK(mailbox.drain() == 1);
+
+    // concurrent producers
+    constexpr int kCount = 200;
+
+    Slot target2;
+    ustream::MailboxSlot<1024, int, int> mailbox2(target2);
+    ustream::SharedSignal<int, int> sig2;
+
+    CHECK(sig2.connect(mailbox2));
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; p++) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kCount; i++) {
+                sig2.emit(p, i);
+            }
+        });
+    }
+
+    // drain while the producers run
+    int received = 0;
+    while (received < kCount) {
+        received += static_cast<int>(mailbox2.drain());
+    }
+
+    for (auto& p : producers) {
+        p.join();
+    }
+
+    received += static_cast<int>(mailbox2.drain());
+
+    CHECK(mailbox2.dropped() == 0);
+    CHECK(received == 4 * kCount);
+    CHECK(target2.mCount == 4 * kCount);
+    CHECK(target2.mOrdered);
+}
+
+TEST_CASE("shared signal tests") {
+
+    struct Slot : ustream::ISharedSlot<int> {
+
+        ~Slot() {
+            disconnect();
+        }
+
+        void processSignal(int) override {
+            mCount++;
+        }
+
+        std::atomic<int> mCount { 0 };
+    };
+
+    ustream::SharedSignal<int> sig;
+
+    Slot permanent;
+    CHECK(sig.connect(permanent));
+
+    // emissions with concurrent connections and disconnections
+    constexpr int kEmits = 20000;
+    std::atomic<bool> run { true };
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 2; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kEmits; i++) {
+                sig.emit(i);
+            }
+        });
+    }
+
+    std::vector<std::thread> churn;
+
+    for (int t = 0; t < 3; t++) {
+        churn.emplace_back([&] {
+            Slot slots[3];
+            while (run) {
+                for (auto& s : slots) {
+                    sig.connect(s);
+                }
+                for (auto& s : slots) {
+                    s.disconnect();
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    run = false;
+
+    for (auto& t : churn) {
+        t.join();
+    }
+
+    CHECK(permanent.mCount == 2 * kEmits);
+
+    // the disconnection waits for the emission in progress
+    struct SlowSlot : ustream::ISharedSlot<int> {
+
+        ~SlowSlot() {
+            disconnect();
+        }
+
+        void processSignal(int) override {
+            mEntered = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            mDone = true;
+        }
+
+        std::atomic<bool> mEntered { false };
+        std::atomic<bool> mDone { false };
+    };
+
+    SlowSlot slow;
+    CHECK(sig.connect(slow));
+
+    std::thread emitter([&] { sig.emit(1); });
+
+    while (!slow.mEntered) {
+        std::this_thread::yield();
+    }
+
+    slow.disconnect();
+    CHECK(slow.mDone);
+    CHECK(!slow.isConnected());
+
+    emitter.join();
+}
+
+TEST_CASE("batch tests") {
+
+    struct Slot : ustream::ISlot<int> {
+        void processSignal(int i) override {
+            mSum += i;
+            mCalls++;
+        }
+        int mSum = 0;
+        int mCalls = 0;
+    };
+
+    struct BatchSlot : Slot {
+        void processBatch(ustream::Batch<int> batch) override {
+            for (auto i : batch) {
+                mSum += i;
+            }
+            mBatches++;
+        }
+        int mBatches = 0;
+    };
+
+    ustream::Signal<int> sig;
+
+    Slot slot;
+    BatchSlot batchSlot;
+
+    sig.connect(slot);
+    sig.connect(batchSlot);
+
+    int data[] = { 1, 2, 3, 4 };
+    sig.emitBatch(data);
+
+    // default : one processSignal call per element
+    CHECK(slot.mSum == 10);
+    CHECK(slot.mCalls == 4);
+
+    CHECK(batchSlot.mSum == 10);
+    CHECK(batchSlot.mCalls == 0);
+    CHECK(batchSlot.mBatches == 1);
+
+    std::vector<int> vec = { 5, 6 };
+    sig.emitBatch(vec);
+
+    CHECK(slot.mSum == 21);
+    CHECK(batchSlot.mSum == 21);
+    CHECK(batchSlot.mBatches == 2);
+
+    sig.emitBatch({ data, 2 });
+
+    CHECK(slot.mSum == 24);
+
+    // mutable references
+    struct Incrementer : ustream::ISlot<int&> {
+        void processSignal(int& i) override {
+            i++;
+        }
+    };
+
+    ustream::Signal<int&> refSig;
+    Incrementer inc;
+    refSig.connect(inc);
+
+    refSig.emitBatch(data);
+
+    CHECK(data[0] == 2);
+    CHECK(data[3] == 5);
+
+    // several arguments
+    struct PairSlot : ustream::ISlot<int, float> {
+        void processSignal(int i, float f) override {
+            mSum += static_cast<float>(i) * f;
+        }
+        float mSum = 0;
+    };
+
+    ustream::Signal<int, float> pairSig;
+    PairSlot pairSlot;
+    pairSig.connect(pairSlot);
+
+    std::tuple<int, float> pairs[] = { { 1, 0.5f }, { 2, 2.f } };
+    pairSig.emitBatch(pairs);
+
+    CHECK(pairSlot.mSum == doctest::Approx(4.5f));
+}
+
+TEST_CASE("instrumentation tests") {
+
+    struct Slot : ustream::ISlot<int> {
+        void processSignal(int i) override {
+            std::this_thread::sleep_for(std::chrono::milliseconds(i));
+        }
+    };
+
+    // no overhead without instrumentation
+    static_assert(sizeof(ustream::Signal<int>) == sizeof(ulink::List<ustream::ISlot<int>>));
+
+    ustream::InstrumentedSignal<int> sig;
+
+    Slot slot1;
+    Slot slot2;
+
+    sig.connect(slot1);
+    sig.connect(slot2);
+
+    sig.emit(0);
+    sig.emit(2);
+
+    const auto& stats = sig.instrumentation();
+
+    CHECK(stats.emitCount() == 2);
+    CHECK(stats.slotCallCount() == 4);
+    CHECK(stats.maxSlotTime() >= std::chrono::milliseconds(2));
+    CHECK(stats.totalSlotTime() >= std::chrono::milliseconds(4));
+
+    sig.instrumentation().reset();
+
+    CHECK(stats.emitCount() == 0);
+    CHECK(stats.slotCallCount() == 0);
+
+    // ports aren't listed with the default port policy
+    Slot slot3;
+    ustream::open<48>(slot3);
+    ustream::broadcast<48>(0);
+
+    bool listed = false;
+
+    ustream::forEachPort(
+        [&](const char*, const ustream::Instrumentation<>&) {
+            listed = true;
+        }
+    );
+
+    CHECK(!listed);
+
+    ustream::close(slot3);
+}
+
+namespace {
+
+    int sFreeFunctionData = 0;
+
+    void freeFunction(int i) {
+        sFreeFunctionData = i;
+    }
+
+}
+
+TEST_CASE("delegate tests") {
+
+    // no virtual method
+    struct Receiver {
+        void onValue(int i) {
+            mRXData = i;
+        }
+        int mRXData = 0;
+    };
+
+    static_assert(!std::is_polymorphic_v<Receiver>);
+
+    Receiver receiver;
+
+    ustream::Delegate<&Receiver::onValue> memberSlot(receiver);
+    ustream::Delegate<&freeFunction> functionSlot;
+
+    int lambdaData = 0;
+    ustream::CallableSlot lambdaSlot([&lambdaData](int i) { lambdaData = i; });
+
+    static_assert(std::is_base_of_v<ustream::ISlot<int>, decltype(lambdaSlot)>);
+
+    ustream::Signal<int> sig;
+
+    CHECK(sig.connect(memberSlot));
+    CHECK(sig.connect(functionSlot));
+    CHECK(sig.connect(lambdaSlot));
+
+    sig.emit(42);
+
+    CHECK(receiver.mRXData == 42);
+    CHECK(sFreeFunctionData == 42);
+    CHECK(lambdaData == 42);
+
+    functionSlot.disconnect();
+
+    ustream::open<49>(functionSlot);
+    ustream::broadcast<49>(7);
+
+    CHECK(sFreeFunctionData == 7);
+    CHECK(receiver.mRXData == 42);
+
+    ustream::close(functionSlot);
+
+    // const member function and references
+    struct Reader {
+        void read(int& i) const {
+            i = mValue;
+        }
+        int mValue = 12;
+    };
+
+    const Reader reader;
+    ustream::Delegate<&Reader::read> readSlot(reader);
+
+    ustream::Signal<int&> refSig;
+    refSig.connect(readSlot);
+
+    int value = 0;
+    refSig.emit(value);
+
+    CHECK(value == 12);
+}
+
+TEST_CASE("keyed signal tests") {
+
+    struct Slot : ustream::KeyedSlot<unsigned, int> {
+
+        using ustream::KeyedSlot<unsigned, int>::KeyedSlot;
+
+        void processSignal(int i) override {
+            mRXData = i;
+            mCount++;
+        }
+
+        int mRXData = 0;
+        int mCount = 0;
+    };
+
+    // 0x101 and 0x201 share the same bucket
+    ustream::KeyedSignal<unsigned, 16, int> sig;
+
+    Slot slot1(0x101);
+    Slot slot2(0x201);
+    Slot slot3(0x102);
+    Slot slot4(0x101);
+
+    CHECK(sig.connect(slot1));
+    CHECK(sig.connect(slot2));
+    CHECK(sig.connect(slot3));
+    CHECK(sig.connect(slot4));
+
+    CHECK(!sig.connect(slot1));
+    CHECK(!slot1.setKey(0x103));
+
+    sig.emit(0x101, 12);
+
+    CHECK(slot1.mRXData == 12);
+    CHECK(slot4.mRXData == 12);
+    CHECK(slot2.mCount == 0);
+    CHECK(slot3.mCount == 0);
+
+    sig.emit(0x201, 13);
+
+    CHECK(slot1.mCount == 1);
+    CHECK(slot2.mRXData == 13);
+
+    sig.emit(0x300, 14);
+
+    CHECK(slot1.mCount == 1);
+    CHECK(slot2.mCount == 1);
+    CHECK(slot3.mCount == 0);
+    CHECK(slot4.mCount == 1);
+
+    CHECK(sig.isConnected(0x102));
+    CHECK(!sig.isConnected(0x300));
+
+    slot3.disconnect();
+    CHECK(!sig.isConnected(0x102));
+
+    CHECK(slot3.setKey(0x300));
+    CHECK(sig.connect(slot3));
+
+    sig.emit(0x300, 15);
+    CHECK(slot3.mRXData == 15);
+
+    // enum keys
+    enum class eMessage { Speed, Temperature, Count };
+
+    struct MessageSlot : ustream::KeyedSlot<eMessage, float> {
+        using ustream::KeyedSlot<eMessage, float>::KeyedSlot;
+        void processSignal(float f) override {
+            mValue = f;
+        }
+        float mValue = 0;
+    };
+
+    ustream::KeyedSignal<eMessage, static_cast<std::size_t>(eMessage::Count), float> messages;
+
+    MessageSlot speed(eMessage::Speed);
+    MessageSlot temperature(eMessage::Temperature);
+
+    messages.connect(speed);
+    messages.connect(temperature);
+
+    messages.emit(eMessage::Temperature, 21.5f);
+
+    CHECK(speed.mValue == 0.f);
+    CHECK(temperature.mValue == 21.5f);
+}
+
+TEST_CASE("consumable signal tests") {
+
+    struct Consumer : ustream::IConsumer<int> {
+
+        Consumer(int inAccepted) : mAccepted(inAccepted) {}
+
+        bool processSignal(int i) override {
+            mCount++;
+            return i == mAccepted;
+        }
+
+        int mAccepted;
+        int mCount = 0;
+    };
+
+    ustream::ConsumableSignal<3, int> sig;
+
+    Consumer logger(-1);
+    Consumer handler(1);
+    Consumer monitor(2);
+
+    CHECK(!sig.isConnected());
+
+    CHECK(sig.connect(logger, 2));
+    CHECK(sig.connect(handler));
+    CHECK(sig.connect(monitor, 1));
+
+    CHECK(!sig.connect(logger));
+    CHECK(!sig.connect(logger, 3));
+
+    CHECK(sig.isConnected());
+
+    // consumed by the highest priority consumer
+    CHECK(sig.emit(1));
+    CHECK(handler.mCount == 1);
+    CHECK(monitor.mCount == 0);
+    CHECK(logger.mCount == 0);
+
+    CHECK(sig.emit(2));
+    CHECK(handler.mCount == 2);
+    CHECK(monitor.mCount == 1);
+    CHECK(logger.mCount == 0);
+
+    // not consumed
+    CHECK(!sig.emit(3));
+    CHECK(handler.mCount == 3);
+    CHECK(monitor.mCount == 2);
+    CHECK(logger.mCount == 1);
+
+    handler.disconnect();
+
+    CHECK(!sig.emit(1));
+    CHECK(handler.mCount == 3);
+    CHECK(logger.mCount == 2);
+
+    // a result signal of consumers, accepting the other combiners
+    static_assert(std::is_same_v<ustream::IConsumer<int>, ustream::IResultSlot<bool, int>>);
+
+    CHECK(sig.emit(ustream::AnyOf(), 2));
+    CHECK(monitor.mCount == 4);
+    CHECK(logger.mCount == 2);
+
+    CHECK(!sig.emit(ustream::AllOf(), 2));
+    CHECK(logger.mCount == 3);
+}
+
+TEST_CASE("priority signal tests") {
+
+    struct Slot : ustream::ISlot<int> {
+
+        Slot(std::vector<int>& inOrder, int inID) : mOrder(inOrder), mID(inID) {}
+
+        void processSignal(int) override {
+            mOrder.push_back(mID);
+        }
+
+        std::vector<int>& mOrder;
+        int mID;
+    };
+
+    std::vector<int> order;
+
+    ustream::PrioritySignal<3, int> sig;
+
+    Slot logger(order, 1);
+    Slot monitor(order, 2);
+    Slot controller(order, 3);
+    Slot display(order, 4);
+
+    CHECK(sig.connect(logger, 2));
+    CHECK(sig.connect(controller, 1));
+    CHECK(sig.connect(monitor));
+    CHECK(sig.connect(display, 1));
+
+    CHECK(!sig.connect(logger, 0));
+    CHECK(!sig.connect(logger, 3));
+
+    sig.emit(0);
+
+    CHECK(order == std::vector<int>{ 2, 4, 3, 1 });
+
+    monitor.disconnect();
+    display.disconnect();
+    order.clear();
+
+    sig.emit(0);
+
+    CHECK(order == std::vector<int>{ 3, 1 });
+
+    controller.disconnect();
+    logger.disconnect();
+
+    CHECK(!sig.isConnected());
+}
+
+TEST_CASE("fifo signal tests") {
+
+    struct Slot : ustream::ISlot<int> {
+
+        Slot(std::vector<int>& inOrder, int inID) : mOrder(inOrder), mID(inID) {}
+
+        void processSignal(int) override {
+            mOrder.push_back(mID);
+        }
+
+        std::vector<int>& mOrder;
+        int mID;
+    };
+
+    std::vector<int> order;
+
+    Slot slot1(order, 1);
+    Slot slot2(order, 2);
+    Slot slot3(order, 3);
+
+    ustream::FifoSignal<int> sig;
+
+    sig.connect(slot1);
+    sig.connect(slot2);
+    sig.connect(slot3);
+
+    sig.emit(0);
+
+    CHECK(order == std::vector<int>{ 1, 2, 3 });
+
+    // reconnected slots go to the end
+    slot1.disconnect();
+    sig.connect(slot1);
+    order.clear();
+
+    sig.emit(0);
+
+    CHECK(order == std::vector<int>{ 2, 3, 1 });
+
+    // combined with priority levels
+    using policy_t = ustream::PrioritySignalPolicy<2, ustream::OrderSignalPolicy<ustream::eOrder::FIFO>>;
+
+    slot1.disconnect();
+    slot2.disconnect();
+    slot3.disconnect();
+    order.clear();
+
+    ustream::BasicSignal<policy_t, int> prioritySig;
+
+    prioritySig.connect(slot1, 1);
+    prioritySig.connect(slot2);
+    prioritySig.connect(slot3);
+
+    prioritySig.emit(0);
+
+    CHECK(order == std::vector<int>{ 2, 3, 1 });
+}
+
+TEST_CASE("connections tests") {
+
+    struct Slot : ustream::ISlot<int> {
+        void processSignal(int i) override {
+            mSum += i;
+            mCount++;
+        }
+        int mSum = 0;
+        int mCount = 0;
+    };
+
+    Slot slot;
+
+    ustream::Signal<int> sig1;
+    ustream::PrioritySignal<2, int> sig2;
+    ustream::FifoSignal<int> sig3;
+
+    ustream::Connections<4, int> connections(slot);
+
+    // only the sources linking their slots are accepted
+    static_assert(ustream::detail::isListSignal<ustream::Signal<int>>);
+    static_assert(ustream::detail::isListSignal<ustream::ChainedSignal<int>>);
+    static_assert(!ustream::detail::isListSignal<ustream::FlatSignal<4, int>>);
+    static_assert(!ustream::detail::isListSignal<ustream::SharedSignal<int>>);
+
+    CHECK(connections.capacity() == 4);
+    CHECK(connections.size() == 0);
+
+    CHECK(connections.connect(sig1));
+    CHECK(connections.connect(sig2, 1));
+    CHECK(connections.connect(sig3));
+    CHECK(connections.open<50>());
+
+    // no free connection
+    CHECK(!connections.connect(sig1));
+
+    CHECK(connections.size() == 4);
+    CHECK(!slot.isConnected());
+
+    sig1.emit(1);
+    sig2.emit(2);
+    sig3.emit(3);
+    ustream::broadcast<50>(4);
+
+    CHECK(slot.mSum == 10);
+    CHECK(slot.mCount == 4);
+
+    connections.disconnect();
+
+    CHECK(connections.size() == 0);
+    CHECK(!sig1.isConnected());
+    CHECK(!sig2.isConnected());
+    CHECK(!sig3.isConnected());
+
+    sig1.emit(1);
+    ustream::broadcast<50>(4);
+
+    CHECK(slot.mCount == 4);
+
+    // a slot connected directly can also use connections
+    CHECK(sig1.connect(slot));
+
+    {
+        ustream::Connections<1, int> scoped(slot);
+        CHECK(scoped.connect(sig2));
+        sig1.emit(1);
+        sig2.emit(1);
+        CHECK(slot.mCount == 6);
+    }
+
+    // disconnected on destruction
+    CHECK(!sig2.isConnected());
+    slot.disconnect();
+}
+
+TEST_CASE("lazy emission tests") {
+
+    struct Slot : ustream::ISlot<const std::string&> {
+        void processSignal(const std::string& s) override {
+            mRXData = s;
+        }
+        std::string mRXData;
+    };
+
+    struct PairSlot : ustream::ISlot<int, float> {
+        void processSignal(int i, float f) override {
+            mSum = i + f;
+        }
+        float mSum = 0;
+    };
+
+    int factoryCalls = 0;
+
+    auto factory = [&] {
+        factoryCalls++;
+        return std::string("diagnostic ") + std::to_string(factoryCalls);
+    };
+
+    Slot slot;
+    ustream::Signal<const std::string&> sig;
+
+    sig.emitLazy(factory);
+    CHECK(factoryCalls == 0);
+
+    sig.connect(slot);
+
+    sig.emitLazy(factory);
+    CHECK(factoryCalls == 1);
+    CHECK(slot.mRXData == "diagnostic 1");
+
+    PairSlot pairSlot;
+    ustream::Signal<int, float> pairSig;
+
+    pairSig.connect(pairSlot);
+    pairSig.emitLazy([] { return std::make_tuple(1, 0.5f); });
+    CHECK(pairSlot.mSum == 1.5f);
+
+    // broadcast
+    ustream::broadcastLazy<51>(factory);
+    CHECK(factoryCalls == 1);
+
+    slot.disconnect();
+    ustream::open<51>(slot);
+
+    // built once for the const ref port
+    ustream::broadcastLazy<51>(factory);
+    CHECK(factoryCalls == 2);
+    CHECK(slot.mRXData == "diagnostic 2");
+
+    struct ValueSlot : ustream::ISlot<std::string> {
+        void processSignal(std::string s) override {
+            mRXData = s;
+        }
+        std::string mRXData;
+    };
+
+    ValueSlot valueSlot;
+    ustream::open<51>(valueSlot);
+
+    // built once for both ports
+    ustream::broadcastLazy<51>(factory);
+    CHECK(factoryCalls == 3);
+    CHECK(slot.mRXData == "diagnostic 3");
+    CHECK(valueSlot.mRXData == "diagnostic 3");
+
+    ustream::close(slot);
+    ustream::close(valueSlot);
+}
+
+TEST_CASE("result signal tests") {
+
+    struct CurrentLimit : ustream::IResultSlot<int, int> {
+
+        CurrentLimit(int inLimit) : mLimit(inLimit) {}
+
+        int processSignal(int inTemperature) override {
+            mCount++;
+            return inTemperature > 50 ? mLimit / 2 : mLimit;
+        }
+
+        int mLimit;
+        int mCount = 0;
+    };
+
+    ustream::ResultSignal<int, int> limits;
+
+    CHECK(!limits.emit(ustream::Min<int>(), 20).has_value());
+    CHECK(limits.emit(ustream::Sum<int>(), 20) == 0);
+
+    CurrentLimit battery(30);
+    CurrentLimit motor(20);
+    CurrentLimit wiring(40);
+
+    CHECK(limits.connect(battery));
+    CHECK(limits.connect(motor));
+    CHECK(limits.connect(wiring));
+    CHECK(!limits.connect(wiring));
+
+    CHECK(limits.emit(ustream::Min<int>(), 20) == 20);
+    CHECK(limits.emit(ustream::Max<int>(), 20) == 40);
+    CHECK(limits.emit(ustream::Sum<int>(), 60) == 45);
+    CHECK(limits.emit(ustream::Sum<int>(10), 20) == 100);
+
+    // combiner kept by the caller
+    ustream::Max<int> max;
+    limits.emit(max, 60);
+    CHECK(max.result() == 20);
+
+    limits.emit(20);
+    CHECK(battery.mCount == 6);
+
+    // first non empty
+    struct Lookup : ustream::IResultSlot<std::optional<std::string>, int> {
+
+        Lookup(int inKey, const char* inName) : mKey(inKey), mName(inName) {}
+
+        std::optional<std::string> processSignal(int inKey) override {
+            mCount++;
+            if (inKey == mKey) {
+                return mName;
+            }
+            return std::nullopt;
+        }
+
+        int mKey;
+        const char* mName;
+        int mCount = 0;
+    };
+
+    ustream::ResultSignal<std::optional<std::string>, int> lookup;
+
+    Lookup a(1, "a");
+    Lookup b(2, "b");
+    Lookup c(3, "c");
+
+    // called in reverse connection order : c, b, a
+    lookup.connect(a);
+    lookup.connect(b);
+    lookup.connect(c);
+
+    CHECK(lookup.emit(ustream::FirstNonEmpty<std::string>(), 2) == "b");
+    CHECK(a.mCount == 0);
+    CHECK(b.mCount == 1);
+    CHECK(c.mCount == 1);
+
+    CHECK(!lookup.emit(ustream::FirstNonEmpty<std::string>(), 4).has_value());
+
+    // all of
+    struct Check : ustream::IResultSlot<bool> {
+
+        Check(bool inOk) : mOk(inOk) {}
+
+        bool processSignal() override {
+            mCount++;
+            return mOk;
+        }
+
+        bool mOk;
+        int mCount = 0;
+    };
+
+    ustream::ResultSignal<bool> checks;
+
+    CHECK(checks.emit(ustream::AllOf()));
+
+    Check ok1(true);
+    Check failed(false);
+    Check ok2(true);
+
+    checks.connect(ok1);
+    checks.connect(ok2);
+
+    CHECK(checks.emit(ustream::AllOf()));
+
+    checks.connect(failed);
+
+    CHECK(!checks.emit(ustream::AllOf()));
+    CHECK(ok2.mCount == 1);
+    CHECK(ok1.mCount == 1);
+
+    failed.disconnect();
+    CHECK(checks.emit(ustream::AllOf()));
+
+    // priority levels and connection order from the signal policy
+    ustream::BasicResultSignal<
+        ustream::PrioritySignalPolicy<2, ustream::OrderSignalPolicy<ustream::eOrder::FIFO>>,
+        bool
+    > orderedChecks;
+
+    Check late(false);
+    Check first(true);
+    Check second(false);
+
+    CHECK(orderedChecks.connect(late, 1));
+    CHECK(orderedChecks.connect(first, 0));
+    CHECK(orderedChecks.connect(second, 0));
+    CHECK(!orderedChecks.connect(ok1, 2));
+
+    CHECK(!orderedChecks.emit(ustream::AllOf()));
+    CHECK(first.mCount == 1);
+    CHECK(second.mCount == 1);
+    CHECK(late.mCount == 0);
+}
+
+TEST_CASE("chained signal tests") {
+
+    struct Slot : ustream::ISlot<int> {
+
+        Slot(std::vector<int>& inOrder, int inID) : mOrder(inOrder), mID(inID) {}
+
+        void processSignal(int) override {
+            mOrder.push_back(mID);
+        }
+
+        std::vector<int>& mOrder;
+        int mID;
+    };
+
+    std::vector<int> order;
+
+    ustream::ChainedSignal<int> bus;
+    ustream::ChainedSignal<int> motors;
+    ustream::ChainedSignal<int> leftMotor;
+
+    Slot busSlot(order, 1);
+    Slot motorsSlot(order, 2);
+    Slot leftMotorSlot(order, 3);
+
+    CHECK(!bus.isConnected());
+
+    CHECK(bus.connect(busSlot));
+    CHECK(motors.connect(motorsSlot));
+    CHECK(leftMotor.connect(leftMotorSlot));
+
+    CHECK(bus.connect(motors));
+    CHECK(motors.connect(leftMotor));
+
+    CHECK(motors.parent() == &bus);
+    CHECK(leftMotor.parent() == &motors);
+
+    // already has a parent
+    CHECK(!bus.connect(leftMotor));
+
+    // cycles
+    CHECK(!bus.connect(bus));
+    CHECK(!leftMotor.connect(bus));
+
+    bus.emit(1);
+    CHECK(order == std::vector<int>{ 1, 2, 3 });
+
+    order.clear();
+    motors.emit(1);
+    CHECK(order == std::vector<int>{ 2, 3 });
+
+    order.clear();
+    motors.disconnect();
+    CHECK(motors.parent() == nullptr);
+
+    bus.emit(1);
+    CHECK(order == std::vector<int>{ 1 });
+
+    // no longer an ancestor
+    CHECK(leftMotor.connect(bus));
+
+    order.clear();
+    leftMotor.emit(1);
+    CHECK(order == std::vector<int>{ 3, 1 });
+
+    bus.disconnect();
+
+    {
+        ustream::ChainedSignal<int> scoped;
+        CHECK(scoped.connect(bus));
+    }
+
+    CHECK(bus.parent() == nullptr);
+    CHECK(!leftMotor.connect(motors));
+}
+
+TEST_CASE("fan out tests") {
+
+    struct Extractor : ustream::ISlot<const std::vector<int>&> {
+
+        void processSignal(const std::vector<int>& inFrame) override {
+            long sum = 0;
+            for (int v : inFrame) {
+                sum += v;
+            }
+            mSum = sum;
+            mFrame = &inFrame;
+            mCount++;
+        }
+
+        long mSum = 0;
+        const std::vector<int>* mFrame = nullptr;
+        int mCount = 0;
+    };
+
+    const std::vector<int> frame(1000, 2);
+
+    ustream::ThreadPool<3> pool;
+
+    CHECK(pool.concurrency() == 3);
+
+    ustream::Signal<const std::vector<int>&> sig;
+
+    Extractor extractors[10];
+
+    for (auto& e : extractors) {
+        sig.connect(e);
+    }
+
+    // 8 slots called in parallel, the 2 others by the emitting thread
+    ustream::FanOut<8, const std::vector<int>&> fanOut;
+
+    for (int i = 0; i < 50; i++) {
+        fanOut.emit(pool, sig, frame);
+    }
+
+    for (auto& e : extractors) {
+        CHECK(e.mCount == 50);
+        CHECK(e.mSum == 2000);
+        // shared by reference
+        CHECK(e.mFrame == &frame);
+    }
+
+    fanOut.start(pool, sig, frame);
+    fanOut.wait();
+
+    for (auto& e : extractors) {
+        CHECK(e.mCount == 51);
+    }
+
+    // no slot
+    ustream::Signal<const std::vector<int>&> empty;
+    fanOut.emit(pool, empty, frame);
+    fanOut.start(pool, empty, frame);
+    fanOut.wait();
+
+    // single slot, called by the emitting thread
+    Extractor single;
+    empty.connect(single);
+    fanOut.emit(pool, empty, frame);
+    CHECK(single.mCount == 1);
+
+    // tasks
+    struct Counter : ustream::Task {
+        void run() override {
+            mCount++;
+        }
+        std::atomic<int> mCount { 0 };
+    };
+
+    Counter counter;
+
+    {
+        ustream::ThreadPool<2> tasks;
+        tasks.post(counter);
+    }
+
+    // queued tasks run before the pool is destroyed
+    CHECK(counter.mCount == 1);
+}
+
+TEST_CASE("routed slot tests") {
+
+    struct Slot : ustream::ISlot<int> {
+
+        Slot(ustream::IExecutor& inExecutor) : mExecutor(inExecutor) {}
+
+        void processSignal(int i) override {
+            if (mRunning.fetch_add(1) != 0) {
+                mConcurrent = true;
+            }
+            if (!mExecutor.isCurrent()) {
+                mWrongThread = true;
+            }
+            // widens the window for a concurrent call
+            std::this_thread::yield();
+            mSum += i;
+            mCount++;
+            mRunning.fetch_sub(1);
+        }
+
+        ustream::IExecutor& mExecutor;
+        std::atomic<int> mRunning { 0 };
+        std::atomic<int> mCount { 0 };
+        long mSum = 0;
+        bool mConcurrent = false;
+        bool mWrongThread = false;
+    };
+
+    // routed to the main thread
+    ustream::EventLoop loop;
+
+    CHECK(loop.isCurrent());
+
+    Slot uiSlot(loop);
+    ustream::RoutedSlot<64, int> uiRoute(uiSlot, loop);
+
+    ustream::Signal<int> sig;
+    sig.connect(uiRoute);
+
+    // called inline from the loop's thread
+    sig.emit(1);
+    CHECK(uiSlot.mCount == 1);
+
+    std::thread producer(
+        [&] {
+            CHECK(!loop.isCurrent());
+            for (int i = 0; i < 10; i++) {
+                sig.emit(1);
+            }
+        }
+    );
+    producer.join();
+
+    CHECK(uiSlot.mCount == 1);
+
+    // a single drain task was posted
+    CHECK(loop.poll() == 1);
+    CHECK(uiSlot.mCount == 11);
+    CHECK(loop.poll() == 0);
+
+    // routed to a pool
+    ustream::ThreadPool<3> pool;
+
+    CHECK(!pool.isCurrent());
+
+    Slot workerSlot(pool);
+    ustream::RoutedSlot<1024, int> workerRoute(workerSlot, pool);
+
+    ustream::Signal<int> workerSig;
+    workerSig.connect(workerRoute);
+
+    std::thread producers[2];
+
+    for (auto& p : producers) {
+        p = std::thread(
+            [&] {
+                for (int i = 0; i < 200; i++) {
+                    workerSig.emit(2);
+                }
+            }
+        );
+    }
+
+    for (auto& p : producers) {
+        p.join();
+    }
+
+    while (workerSlot.mCount != 400) {
+        std::this_thread::yield();
+    }
+
+    CHECK(workerRoute.dropped() == 0);
+    CHECK(workerSlot.mSum == 800);
+    CHECK(!workerSlot.mConcurrent);
+    CHECK(!workerSlot.mWrongThread);
+    CHECK(!uiSlot.mWrongThread);
+
+    while (!workerRoute.idle()) {
+        std::this_thread::yield();
+    }
+
+    CHECK(uiRoute.idle());
+
+    // emitted from the pool's threads and from another thread
+    struct Emitter : ustream::Task {
+
+        Emitter(ustream::Signal<int>& inSignal) : mSignal(inSignal) {}
+
+        void run() override {
+            for (int i = 0; i < 500; i++) {
+                mSignal.emit(1);
+            }
+            mDone = true;
+        }
+
+        ustream::Signal<int>& mSignal;
+        std::atomic<bool> mDone { false };
+    };
+
+    Emitter emitters[2] = { Emitter(workerSig), Emitter(workerSig) };
+
+    for (auto& e : emitters) {
+        pool.post(e);
+    }
+
+    std::thread outside(
+        [&] {
+            for (int i = 0; i < 500; i++) {
+                workerSig.emit(1);
+            }
+        }
+    );
+    outside.join();
+
+    while (!emitters[0].mDone || !emitters[1].mDone) {
+        std::this_thread::yield();
+    }
+
+    while (workerSlot.mCount != 400 + 1500 - static_cast<int>(workerRoute.dropped())) {
+        std::this_thread::yield();
+    }
+
+    while (!workerRoute.idle()) {
+        std::this_thread::yield();
+    }
+
+    CHECK(!workerSlot.mConcurrent);
+    CHECK(!workerSlot.mWrongThread);
+}
+
+TEST_CASE("strand tests") {
+
+    struct State {
+        std::atomic<bool> mConcurrent { false };
+        std::atomic<bool> mWrongThread { false };
+        std::atomic<int> mDone { 0 };
+    };
+
+    struct Counter : ustream::Task {
+
+        Counter(State& inState, ustream::Strand& inStrand, std::atomic<int>& inRunning, int& inCount) :
+            mState(inState), mStrand(inStrand), mRunning(inRunning), mCount(inCount) {}
+
+        void run() override {
+            if (mRunning.fetch_add(1) != 0) {
+                mState.mConcurrent = true;
+            }
+            if (!mStrand.isCurrent()) {
+                mState.mWrongThread = true;
+            }
+            mCount++;
+            mRunning.fetch_sub(1);
+            mState.mDone++;
+        }
+
+        State& mState;
+        ustream::Strand& mStrand;
+        std::atomic<int>& mRunning;
+        int& mCount;
+    };
+
+    State state;
+
+    ustream::ThreadPool<4> pool;
+
+    // several strands sharing the pool
+    ustream::Strand strands[3] = {
+        ustream::Strand(pool), ustream::Strand(pool), ustream::Strand(pool)
+    };
+
+    std::atomic<int> running[3] = {};
+    int counts[3] = {};
+
+    std::vector<std::unique_ptr<Counter>> tasks;
+
+    for (int i = 0; i < 300; i++) {
+        tasks.emplace_back(new Counter(state, strands[i % 3], running[i % 3], counts[i % 3]));
+    }
+
+    CHECK(!strands[0].isCurrent());
+
+    std::thread producers[2];
+
+    for (int p = 0; p < 2; p++) {
+        producers[p] = std::thread(
+            [&, p] {
+                for (int i = p; i < 300; i += 2) {
+                    strands[i % 3].post(*tasks[i]);
+                }
+            }
+        );
+    }
+
+    for (auto& p : producers) {
+        p.join();
+    }
+
+    while (state.mDone != 300) {
+        std::this_thread::yield();
+    }
+
+    for (auto& s : strands) {
+        while (!s.idle()) {
+            std::this_thread::yield();
+        }
+    }
+
+    CHECK(counts[0] == 100);
+    CHECK(counts[1] == 100);
+    CHECK(counts[2] == 100);
+    CHECK(!state.mConcurrent);
+    CHECK(!state.mWrongThread);
+
+    // routed slots sharing a state through a strand
+    struct Slot : ustream::ISlot<int> {
+
+        Slot(long& inSum, std::atomic<int>& inRunning) : mSum(inSum), mRunning(inRunning) {}
+
+        void processSignal(int i) override {
+            if (mRunning.fetch_add(1) != 0) {
+                mConcurrent = true;
+            }
+            mSum += i;
+            mRunning.fetch_sub(1);
+        }
+
+        long& mSum;
+        std::atomic<int>& mRunning;
+        bool mConcurrent = false;
+    };
+
+    long sum = 0;
+    std::atomic<int> slotRunning { 0 };
+
+    Slot slot1(sum, slotRunning);
+    Slot slot2(sum, slotRunning);
+
+    ustream::Strand strand(pool);
+
+    ustream::RoutedSlot<1024, int> route1(slot1, strand);
+    ustream::RoutedSlot<1024, int> route2(slot2, strand);
+
+    ustream::Signal<int> sig1;
+    ustream::Signal<int> sig2;
+
+    sig1.connect(route1);
+    sig2.connect(route2);
+
+    std::thread emitter1([&] { for (int i = 0; i < 500; i++) { sig1.emit(1); } });
+    std::thread emitter2([&] { for (int i = 0; i < 500; i++) { sig2.emit(2); } });
+
+    emitter1.join();
+    emitter2.join();
+
+    while (!route1.idle() || !route2.idle() || !strand.idle()) {
+        std::this_thread::yield();
+    }
+
+    CHECK(sum == 1500);
+    CHECK(!slot1.mConcurrent);
+    CHECK(!slot2.mConcurrent);
+}
+
+namespace {
+
+    template<typename wait_t>
+    void checkMulticastRing(int inCount) {
+
+        struct Slot : ustream::ISlot<const int&> {
+            void processSignal(const int& i) override {
+                mOrdered = mOrdered && (i == mNext);
+                mNext = i + 1;
+                mSum += i;
+            }
+            int mNext = 0;
+            long mSum = 0;
+            bool mOrdered = true;
+        };
+
+        using ring_t = ustream::MulticastRing<int, 256, 3, wait_t>;
+
+        ring_t ring;
+
+        Slot slots[3];
+
+        typename ring_t::Consumer consumers[3] = {
+            typename ring_t::Consumer(slots[0]),
+            typename ring_t::Consumer(slots[1]),
+            typename ring_t::Consumer(slots[2])
+        };
+
+        for (auto& c : consumers) {
+            CHECK(ring.attach(c));
+        }
+
+        Slot extra;
+        typename ring_t::Consumer extraConsumer(extra);
+        CHECK(!ring.attach(extraConsumer));
+        CHECK(!ring.attach(consumers[0]));
+
+        std::thread threads[3];
+
+        for (int i = 0; i < 3; i++) {
+            threads[i] = std::thread(
+                [&consumers, i] {
+                    while (consumers[i].wait() != 0);
+                }
+            );
+        }
+
+        ustream::Signal<const int&> sig;
+        sig.connect(ring);
+
+        for (int i = 0; i < inCount; i++) {
+            sig.emit(i);
+        }
+
+        ring.close();
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        const long expected = static_cast<long>(inCount) * (inCount - 1) / 2;
+
+        for (auto& s : slots) {
+            CHECK(s.mOrdered);
+            CHECK(s.mNext == inCount);
+            CHECK(s.mSum == expected);
+        }
+    }
+
+}
+
+TEST_CASE("multicast ring tests") {
+
+    struct Slot : ustream::ISlot<const int&> {
+        void processSignal(const int& i) override {
+            mData = &i;
+            mCount++;
+        }
+        const int* mData = nullptr;
+        int mCount = 0;
+    };
+
+    using ring_t = ustream::MulticastRing<int, 4, 2>;
+
+    ring_t ring;
+
+    // no consumer : nothing is gating the producer
+    for (int i = 0; i < 10; i++) {
+        ring.processSignal(i);
+    }
+
+    Slot slot1;
+    Slot slot2;
+    ring_t::Consumer consumer1(slot1);
+    ring_t::Consumer consumer2(slot2);
+
+    CHECK(ring.attach(consumer1));
+    CHECK(ring.attach(consumer2));
+
+    CHECK(consumer1.poll() == 0);
+
+    ring.processSignal(10);
+    ring.processSignal(11);
+
+    CHECK(consumer1.poll() == 2);
+    CHECK(*slot1.mData == 11);
+
+    ring.processSignal(12);
+
+    CHECK(consumer1.poll() == 1);
+    CHECK(consumer2.poll() == 3);
+
+    // both consumers read the same element
+    CHECK(slot1.mData == slot2.mData);
+    CHECK(slot2.mCount == 3);
+
+    // a slot taking the elements by value receives a copy
+    struct ValueSlot : ustream::ISlot<std::string> {
+        void processSignal(std::string s) override {
+            mText += s;
+        }
+        std::string mText;
+    };
+
+    ValueSlot valueSlot;
+    ustream::MulticastRing<std::string, 4, 1> textRing;
+    ustream::MulticastRing<std::string, 4, 1>::Consumer valueConsumer(valueSlot);
+
+    CHECK(textRing.attach(valueConsumer));
+
+    ustream::Signal<const std::string&> text;
+    text.connect(textRing);
+    text.emit("ab");
+    text.emit("cd");
+
+    CHECK(valueConsumer.poll() == 2);
+    CHECK(valueSlot.mText == "abcd");
+
+    checkMulticastRing<ustream::SpinWait>(2000);
+    checkMulticastRing<ustream::YieldWait>(20000);
+    checkMulticastRing<ustream::BlockWait>(20000);
+}
+
+TEST_CASE("chained signal batch and lazy emission tests") {
+
+    struct Slot : ustream::ISlot<int> {
+        void processSignal(int i) override {
+            mSum += i;
+            mCount++;
+        }
+        int mSum = 0;
+        int mCount = 0;
+    };
+
+    ustream::ChainedSignal<int> parent;
+    ustream::ChainedSignal<int> child;
+
+    Slot childSlot;
+
+    child.connect(childSlot);
+    parent.connect(child);
+
+    // the parent's only link is the child signal
+    CHECK(parent.isConnected());
+
+    int factoryCalls = 0;
+
+    parent.emitLazy(
+        [&] {
+            factoryCalls++;
+            return 5;
+        }
+    );
+
+    CHECK(factoryCalls == 1);
+    CHECK(childSlot.mSum == 5);
+
+    const int data[] = { 1, 2, 3 };
+    parent.emitBatch(data);
+
+    CHECK(childSlot.mCount == 4);
+    CHECK(childSlot.mSum == 11);
+
+    child.disconnect();
+
+    parent.emitLazy(
+        [&] {
+            factoryCalls++;
+            return 5;
+        }
+    );
+
+    CHECK(factoryCalls == 1);
+}
+
+TEST_CASE("broadcast decay tests") {
+
+    struct TextSlot : ustream::ISlot<const char*> {
+        void processSignal(const char* s) override {
+            mText = s;
+        }
+        std::string mText;
+    };
+
+    TextSlot slot;
+    ustream::open<53>(slot);
+
+    // the string literal decays to a pointer
+    ustream::broadcast<53>("hello");
+    CHECK(slot.mText == "hello");
+
+    const char text[] = "world";
+    ustream::broadcast<53>(text);
+    CHECK(slot.mText == "world");
+
+    ustream::close(slot);
+
+    struct SharedTextSlot : ustream::ISharedSlot<const char*> {
+        ~SharedTextSlot() {
+            disconnect();
+        }
+        void processSignal(const char* s) override {
+            mText = s;
+        }
+        std::string mText;
+    };
+
+    SharedTextSlot sharedSlot;
+    ustream::global::open<53>(sharedSlot);
+
+    ustream::global::broadcast<53>("global");
+    CHECK(sharedSlot.mText == "global");
+
+    ustream::global::close(sharedSlot);
+
+    // explicit references reach the mutable reference port
+    struct IncrementSlot : ustream::ISlot<int&> {
+        void processSignal(int& i) override {
+            i++;
+        }
+    };
+
+    IncrementSlot incrementSlot;
+    ustream::open<54>(incrementSlot);
+
+    int x = 0;
+    ustream::broadcast<54, int&>(x);
+    CHECK(x == 1);
+
+    // a value broadcast doesn't reach it
+    ustream::broadcast<54>(x);
+    CHECK(x == 1);
+
+    ustream::close(incrementSlot);
+}